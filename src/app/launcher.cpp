@@ -3,6 +3,8 @@
 
 #include "meshers/StructuredMesher.h"
 #include "utils/GridTools.h"
+#include "utils/Parallel.h"
+#include "utils/ValidationLevel.h"
 
 #include <boost/program_options.hpp>
 #include <nlohmann/json.hpp>
@@ -11,6 +13,8 @@
 #include <filesystem>
 #include <fstream>
 #include <array>
+#include <chrono>
+#include <map>
 
 
 namespace meshlib::app {
@@ -19,6 +23,60 @@ using namespace vtkIO;
 
 namespace po = boost::program_options;
 
+struct RunOptions {
+    std::string format = "vtk";
+    Compression compression = Compression::ZLib;
+    utils::ValidationLevel validation = utils::ValidationLevel::Full;
+    utils::ExecutionOptions execution;
+    meshers::CacheOptions cache;
+    meshers::CheckpointOptions checkpoints;
+};
+
+struct CaseResult {
+    std::filesystem::path meshFilename;
+    std::filesystem::path gridFilename;
+    std::vector<std::pair<std::string, double>> timings;
+};
+
+// Keeps input geometries read by previous cases. Entries are reloaded when
+// the file is modified.
+class GeometryCache {
+public:
+    Mesh read(const std::filesystem::path& fn)
+    {
+        auto key{ std::filesystem::absolute(fn).lexically_normal() };
+        auto writeTime{ std::filesystem::last_write_time(key) };
+        auto size{ std::filesystem::file_size(key) };
+
+        auto it = entries_.find(key);
+        if (it == entries_.end() || it->second.writeTime != writeTime || it->second.size != size) {
+            it = entries_.insert_or_assign(key, Entry{ writeTime, size, vtkIO::readInputMesh(fn) }).first;
+        }
+        return it->second.mesh;
+    }
+
+private:
+    struct Entry {
+        std::filesystem::file_time_type writeTime;
+        std::uintmax_t size;
+        Mesh mesh;
+    };
+    std::map<std::filesystem::path, Entry> entries_;
+};
+
+class Stopwatch {
+public:
+    double lap()
+    {
+        auto now{ std::chrono::steady_clock::now() };
+        std::chrono::duration<double> elapsed = now - start_;
+        start_ = now;
+        return elapsed.count();
+    }
+private:
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+};
+
 Grid parseGridFromJSON(const nlohmann::json &j)
 {
     std::array<int,3> nCells = {
@@ -37,21 +95,24 @@ Grid parseGridFromJSON(const nlohmann::json &j)
     };
 }
 
-Mesh readMesh(const std::string &fn)
+nlohmann::json readJSON(const std::filesystem::path& fn)
 {
-    nlohmann::json j;
-
-    {
-        std::ifstream i(fn);
-        i >> j;
+    std::ifstream i(fn);
+    if (!i) {
+        throw std::runtime_error("File could not be opened: " + fn.string());
     }
+    nlohmann::json j;
+    i >> j;
+    return j;
+}
 
-    std::filesystem::path caseFolder = std::filesystem::path(fn).parent_path();
+Mesh readMesh(const nlohmann::json& j, const std::filesystem::path& caseFolder, GeometryCache* cache)
+{
     std::filesystem::path objPathFromInput = j["object"]["filename"];
     std::filesystem::path meshObjectPath = caseFolder / objPathFromInput;
 
     std::cout << "-- Reading mesh groups from: " << meshObjectPath;
-    Mesh res = vtkIO::readInputMesh(meshObjectPath);
+    Mesh res = cache ? cache->read(meshObjectPath) : vtkIO::readInputMesh(meshObjectPath);
     std::cout << "....... [OK]" << std::endl;
 
     std::cout << "-- Reading grid from input file";
@@ -61,18 +122,199 @@ Mesh readMesh(const std::string &fn)
     return res;
 }
 
+void checkRunOptions(const RunOptions& opts)
+{
+    if (opts.format != "vtk" && opts.format != "vtu" && opts.format != "vtp") {
+        throw std::runtime_error("Unsupported output format: " + opts.format);
+    }
+}
+
+// Meshes a case and writes the results using `outputPrefix` as path and basename.
+CaseResult runCase(
+    const nlohmann::json& caseJSON,
+    const std::filesystem::path& caseFolder,
+    const std::filesystem::path& outputPrefix,
+    const RunOptions& opts,
+    GeometryCache* cache = nullptr)
+{
+    checkRunOptions(opts);
+    const utils::ScopedExecution execution(opts.execution);
+
+    CaseResult res;
+    Stopwatch stopwatch;
+
+    Mesh mesh = readMesh(caseJSON, caseFolder, cache);
+    res.timings.emplace_back("reading", stopwatch.lap());
+
+    meshlib::meshers::StructuredMesher mesher{mesh, 4, opts.validation, opts.cache, opts.checkpoints};
+    Mesh resultMesh = mesher.mesh();
+    res.timings.emplace_back("meshing", stopwatch.lap());
+    for (const auto& [stage, seconds] : mesher.getStageTimings()) {
+        res.timings.emplace_back("meshing." + stage, seconds);
+    }
+
+    res.meshFilename = outputPrefix.string() + ".tessellator.str." + opts.format;
+    if (opts.format == "vtp") {
+        exportMeshToVTP(res.meshFilename, resultMesh, opts.compression);
+    } else {
+        exportMeshToVTU(res.meshFilename, resultMesh, opts.compression);
+    }
+
+    const std::string gridFormat = opts.format == "vtk" ? "vtk" : "vtu";
+    res.gridFilename = outputPrefix.string() + ".tessellator.grid." + gridFormat;
+    exportGridToVTU(res.gridFilename, resultMesh.grid, opts.compression);
+    res.timings.emplace_back("exporting", stopwatch.lap());
+
+    return res;
+}
+
+nlohmann::json runJob(const nlohmann::json& job, const RunOptions& defaultOpts, GeometryCache& cache)
+{
+    RunOptions opts = defaultOpts;
+    if (job.contains("format")) {
+        opts.format = job["format"].get<std::string>();
+    }
+    if (job.contains("compression")) {
+        opts.compression = toCompression(job["compression"].get<std::string>());
+    }
+    if (job.contains("validation")) {
+        opts.validation = utils::toValidationLevel(job["validation"].get<std::string>());
+    }
+    if (job.contains("backend")) {
+        opts.execution.backend = utils::toExecutionBackend(job["backend"].get<std::string>());
+    }
+    if (job.contains("threads")) {
+        opts.execution.numberOfThreads = job["threads"].get<std::size_t>();
+    }
+
+    CaseResult result;
+    if (job.contains("input")) {
+        std::filesystem::path inputFilename = job["input"].get<std::string>();
+        result = runCase(
+            readJSON(inputFilename),
+            getFolder(inputFilename),
+            getFolder(inputFilename) / getBasename(inputFilename),
+            opts, &cache);
+    } else {
+        if (!job.contains("output")) {
+            throw std::runtime_error("Jobs with an inline case must define an output.");
+        }
+        result = runCase(job, std::filesystem::path(), job["output"].get<std::string>(), opts, &cache);
+    }
+
+    nlohmann::json res;
+    res["status"] = "ok";
+    res["outputs"]["mesh"] = result.meshFilename.string();
+    res["outputs"]["grid"] = result.gridFilename.string();
+    for (const auto& [stage, seconds] : result.timings) {
+        res["timings"][stage] = seconds;
+    }
+    return res;
+}
+
+// Redirects std::cout to another buffer while in scope.
+class ScopedCoutRedirect {
+public:
+    explicit ScopedCoutRedirect(std::streambuf* buffer) : previous_(std::cout.rdbuf(buffer)) {}
+    ~ScopedCoutRedirect() { std::cout.rdbuf(previous_); }
+    ScopedCoutRedirect(const ScopedCoutRedirect&) = delete;
+    ScopedCoutRedirect& operator=(const ScopedCoutRedirect&) = delete;
+
+private:
+    std::streambuf* previous_;
+};
+
+int serveJobs(std::istream& jobs, std::ostream& responses, const RunOptions& opts)
+{
+    // Logs are sent to stderr so that responses are the only output.
+    const ScopedCoutRedirect redirect(std::cerr.rdbuf());
+
+    GeometryCache cache;
+    std::string line;
+    while (std::getline(jobs, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+
+        nlohmann::json job;
+        nlohmann::json response;
+        try {
+            job = nlohmann::json::parse(line);
+            response = runJob(job, opts, cache);
+        } catch (const std::exception& e) {
+            response["status"] = "error";
+            response["message"] = e.what();
+        }
+        if (job.is_object() && job.contains("id")) {
+            response["id"] = job["id"];
+        }
+        responses << response.dump() << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int serve(std::istream& jobs, std::ostream& responses)
+{
+    return serveJobs(jobs, responses, RunOptions());
+}
+
 int launcher(int argc, const char* argv[])
 {
     po::options_description desc("Allowed options");
     desc.add_options()
         ("help,h", "produce help message")
-        ("input,i", po::value<std::string>(), "input file");
+        ("input,i", po::value<std::string>(), "input file")
+        ("format,f", po::value<std::string>()->default_value("vtk"),
+            "output format: vtk, vtu or vtp")
+        ("compression,c", po::value<std::string>()->default_value("zlib"),
+            "compression of vtu and vtp outputs: none, zlib or lz4")
+        ("validation", po::value<std::string>()->default_value("full"),
+            "checks of mesh invariants after each stage: none, cheap or full")
+        ("backend", po::value<std::string>(),
+            "execution backend: serial, threads or tbb")
+        ("threads", po::value<std::size_t>()->default_value(0),
+            "maximum number of threads, 0 uses all the hardware threads")
+        ("cache-dir", po::value<std::string>(),
+            "directory where meshing results are cached and reused")
+        ("cache-size", po::value<std::size_t>()->default_value(1024),
+            "maximum size of the cache in MB")
+        ("checkpoint-dir", po::value<std::string>(),
+            "directory where a snapshot of the mesh is written after each stage")
+        ("resume-from", po::value<std::string>(),
+            "first stage to run, loading the previous one from checkpoint-dir: collapsing or staircasing")
+        ("serve", "reads jobs from stdin, one JSON per line, and writes a JSON response per job to stdout");
 
     po::variables_map vm;
     po::store(po::command_line_parser(argc, argv).
             options(desc).run(), vm);
     po::notify(vm);
 
+    RunOptions opts;
+    opts.format = vm["format"].as<std::string>();
+    opts.compression = toCompression(vm["compression"].as<std::string>());
+    opts.validation = utils::toValidationLevel(vm["validation"].as<std::string>());
+    if (vm.count("backend")) {
+        opts.execution.backend = utils::toExecutionBackend(vm["backend"].as<std::string>());
+    }
+    opts.execution.numberOfThreads = vm["threads"].as<std::size_t>();
+    if (vm.count("cache-dir")) {
+        opts.cache.directory = vm["cache-dir"].as<std::string>();
+    }
+    opts.cache.maxSizeInBytes = std::uintmax_t(vm["cache-size"].as<std::size_t>()) << 20;
+    if (vm.count("checkpoint-dir")) {
+        opts.checkpoints.directory = vm["checkpoint-dir"].as<std::string>();
+    }
+    if (vm.count("resume-from")) {
+        opts.checkpoints.resumeFrom = vm["resume-from"].as<std::string>();
+    }
+    checkRunOptions(opts);
+
+    if (vm.count("serve")) {
+        std::ostream responses{ std::cout.rdbuf() };
+        return serveJobs(std::cin, responses, opts);
+    }
+
     if (vm.count("help") || !vm.count("input")) {
         std::cout << desc << std::endl;
         return EXIT_SUCCESS;
@@ -82,18 +324,13 @@ int launcher(int argc, const char* argv[])
     std::string inputFilename = vm["input"].as<std::string>();
     std::cout << "-- Input file is: " << inputFilename << std::endl;
 
-    Mesh mesh = readMesh(inputFilename);
-
-    // Mesh
-    meshlib::meshers::StructuredMesher mesher{mesh};
-    Mesh resultMesh = mesher.mesh();
-
-    std::filesystem::path outputFolder = getFolder(inputFilename);
-    auto basename = getBasename(inputFilename);
-    exportMeshToVTU(outputFolder / (basename + ".tessellator.str.vtk"), resultMesh);
-    exportGridToVTU(outputFolder / (basename + ".tessellator.grid.vtk"), resultMesh.grid);
+    runCase(
+        readJSON(inputFilename),
+        getFolder(inputFilename),
+        getFolder(inputFilename) / getBasename(inputFilename),
+        opts);
 
     return EXIT_SUCCESS;
 }
 
-}
\ No newline at end of file
+}
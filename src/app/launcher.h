@@ -2,8 +2,18 @@
 
 #include "types/Mesh.h"
 
+#include <iostream>
+
 namespace meshlib::app {
 
 int launcher(int argc, const char* argv[]);
 
+// Runs jobs read from `jobs`, one JSON object per line, writing one JSON
+// response per line to `responses`. A job is either {"input": "<case file>"} 
+// or a case description with an "output" path prefix. Optional "id", 
+// "format", "compression", "validation", "backend" and "threads" entries
+// are also accepted.
+// Input geometries are kept in memory between jobs.
+int serve(std::istream& jobs, std::ostream& responses);
+
 }
\ No newline at end of file
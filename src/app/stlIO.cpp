@@ -0,0 +1,285 @@
+#include "stlIO.h"
+
+#include "utils/FlatHashMap.h"
+#include "utils/Parallel.h"
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <thread>
+
+
+namespace meshlib::stlIO
+{
+
+using namespace utils;
+
+using STLVertex = std::array<float, 3>;
+using STLVertices = std::vector<STLVertex>;
+using Chunk = std::pair<std::size_t, std::size_t>;
+
+const std::size_t BINARY_HEADER_SIZE = 80;
+const std::size_t BINARY_TRIANGLE_SIZE = 50;
+const std::size_t BINARY_NORMAL_SIZE = 12;
+
+std::size_t getNumberOfChunks()
+{
+    return std::max(std::size_t(1), std::size_t(4 * std::thread::hardware_concurrency()));
+}
+
+std::vector<Chunk> splitInChunks(std::size_t size)
+{
+    const std::size_t nChunks = std::min(getNumberOfChunks(), std::max(size, std::size_t(1)));
+    std::vector<Chunk> res;
+    res.reserve(nChunks);
+    for (std::size_t c = 0; c < nChunks; c++) {
+        res.emplace_back(c * size / nChunks, (c + 1) * size / nChunks);
+    }
+    return res;
+}
+
+template <class F>
+void forEachChunk(const std::vector<Chunk>& chunks, F&& f)
+{
+    parallelFor(0, chunks.size(), [&](std::size_t c) {
+        f(c, chunks[c].first, chunks[c].second);
+    });
+}
+
+std::uint32_t readNumberOfBinaryTriangles(const char* data)
+{
+    std::uint32_t res;
+    std::memcpy(&res, data + BINARY_HEADER_SIZE, sizeof(res));
+    return res;
+}
+
+bool isBinary(const char* data, std::size_t size)
+{
+    const std::size_t prefixSize = BINARY_HEADER_SIZE + sizeof(std::uint32_t);
+    if (size >= prefixSize &&
+        prefixSize + BINARY_TRIANGLE_SIZE * readNumberOfBinaryTriangles(data) == size) {
+        return true;
+    }
+    const std::string solid = "solid";
+    return size < solid.size() || std::string(data, solid.size()) != solid;
+}
+
+STLVertices readBinaryVertices(const char* data, std::size_t size)
+{
+    const std::size_t prefixSize = BINARY_HEADER_SIZE + sizeof(std::uint32_t);
+    if (size < prefixSize) {
+        throw std::runtime_error("Binary STL file is too short.");
+    }
+    const std::size_t nTriangles = readNumberOfBinaryTriangles(data);
+    if (size < prefixSize + BINARY_TRIANGLE_SIZE * nTriangles) {
+        throw std::runtime_error("Binary STL file is truncated.");
+    }
+
+    STLVertices res(3 * nTriangles);
+    forEachChunk(splitInChunks(nTriangles),
+        [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t t = begin; t < end; t++) {
+                const char* triangle = data + prefixSize + BINARY_TRIANGLE_SIZE * t;
+                std::memcpy(&res[3 * t], triangle + BINARY_NORMAL_SIZE, 3 * sizeof(STLVertex));
+            }
+        }
+    );
+    return res;
+}
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+const char* skipSpaces(const char* it, const char* end)
+{
+    while (it != end && isSpace(*it)) {
+        ++it;
+    }
+    return it;
+}
+
+const char* parseFloat(const char* it, const char* end, float& value)
+{
+    it = skipSpaces(it, end);
+    if (it != end && *it == '+') {
+        ++it;
+    }
+    auto [ptr, ec] = std::from_chars(it, end, value);
+    if (ec != std::errc()) {
+        throw std::runtime_error("Invalid vertex coordinate in ASCII STL file.");
+    }
+    return ptr;
+}
+
+void readASCIIVerticesInRange(const char* it, const char* end, STLVertices& vertices)
+{
+    const std::string vertexTag = "vertex";
+    while (it != end) {
+        it = skipSpaces(it, end);
+        const char* lineEnd = std::find(it, end, '\n');
+        if (std::size_t(lineEnd - it) > vertexTag.size() &&
+            std::equal(vertexTag.begin(), vertexTag.end(), it) &&
+            isSpace(it[vertexTag.size()])) {
+            STLVertex v;
+            const char* pos = it + vertexTag.size();
+            for (auto& x : v) {
+                pos = parseFloat(pos, lineEnd, x);
+            }
+            vertices.push_back(v);
+        }
+        it = lineEnd;
+    }
+}
+
+STLVertices readASCIIVertices(const char* data, std::size_t size)
+{
+    // Chunk bounds are moved forward to the beginning of a line.
+    auto chunks = splitInChunks(size);
+    for (std::size_t c = 1; c < chunks.size(); c++) {
+        const char* lineBegin = std::find(data + chunks[c].first, data + size, '\n');
+        chunks[c].first = lineBegin - data;
+        chunks[c - 1].second = chunks[c].first;
+    }
+
+    std::vector<STLVertices> chunkVertices(chunks.size());
+    forEachChunk(chunks,
+        [&](std::size_t c, std::size_t begin, std::size_t end) {
+            readASCIIVerticesInRange(data + begin, data + end, chunkVertices[c]);
+        }
+    );
+
+    std::size_t nVertices = 0;
+    for (const auto& vs : chunkVertices) {
+        nVertices += vs.size();
+    }
+    if (nVertices % 3 != 0) {
+        throw std::runtime_error("ASCII STL file contains incomplete facets.");
+    }
+
+    STLVertices res;
+    res.reserve(nVertices);
+    for (const auto& vs : chunkVertices) {
+        res.insert(res.end(), vs.begin(), vs.end());
+    }
+    return res;
+}
+
+// Assigns the same id to vertices with the same position. Ids are given in
+// order of first appearance. Vertices are distributed in shards by hash, each
+// shard being deduplicated independently.
+std::vector<CoordinateId> mergeVertices(const STLVertices& vs, Coordinates& coordinates)
+{
+    using VertexHash = ArrayHash<float, 3>;
+
+    const auto chunks = splitInChunks(vs.size());
+    const std::size_t nShards = chunks.size();
+    auto getShard = [&](const STLVertex& v) {
+        return (mixHash(VertexHash{}(v)) >> 32) % nShards;
+    };
+
+    // Vertex indices are sorted by shard keeping their relative order.
+    std::vector<std::vector<std::size_t>> offsets(chunks.size(), std::vector<std::size_t>(nShards, 0));
+    forEachChunk(chunks,
+        [&](std::size_t c, std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; v++) {
+                offsets[c][getShard(vs[v])]++;
+            }
+        }
+    );
+    std::vector<std::size_t> shardBegin(nShards + 1, 0);
+    std::size_t offset = 0;
+    for (std::size_t s = 0; s < nShards; s++) {
+        shardBegin[s] = offset;
+        for (std::size_t c = 0; c < chunks.size(); c++) {
+            const std::size_t count = offsets[c][s];
+            offsets[c][s] = offset;
+            offset += count;
+        }
+    }
+    shardBegin[nShards] = offset;
+    std::vector<std::size_t> sorted(vs.size());
+    forEachChunk(chunks,
+        [&](std::size_t c, std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; v++) {
+                sorted[offsets[c][getShard(vs[v])]++] = v;
+            }
+        }
+    );
+
+    // Each vertex points to the first vertex with the same position.
+    std::vector<std::size_t> firsts(vs.size());
+    std::vector<Chunk> shards(nShards);
+    for (std::size_t s = 0; s < nShards; s++) {
+        shards[s] = { shardBegin[s], shardBegin[s + 1] };
+    }
+    forEachChunk(shards,
+        [&](std::size_t, std::size_t begin, std::size_t end) {
+            FlatHashMap<STLVertex, std::size_t, VertexHash> positions(end - begin);
+            for (std::size_t i = begin; i < end; i++) {
+                const std::size_t v = sorted[i];
+                firsts[v] = *positions.emplace(vs[v], v).first;
+            }
+        }
+    );
+
+    std::vector<CoordinateId> res(vs.size());
+    for (std::size_t v = 0; v < vs.size(); v++) {
+        if (firsts[v] == v) {
+            res[v] = coordinates.size();
+            coordinates.push_back(Coordinate({ vs[v][0], vs[v][1], vs[v][2] }));
+        }
+        else {
+            res[v] = res[firsts[v]];
+        }
+    }
+    return res;
+}
+
+Mesh buildMesh(const STLVertices& vertices)
+{
+    Mesh res;
+    const auto ids = mergeVertices(vertices, res.coordinates);
+
+    res.groups.resize(1);
+    auto& elements = res.groups[0].elements;
+    elements.reserve(ids.size() / 3);
+    for (std::size_t t = 0; 3 * t < ids.size(); t++) {
+        const auto& a = ids[3 * t];
+        const auto& b = ids[3 * t + 1];
+        const auto& c = ids[3 * t + 2];
+        if (a != b && a != c && b != c) {
+            elements.push_back(Element({ a, b, c }, Element::Type::Surface));
+        }
+    }
+    return res;
+}
+
+Mesh readSTL(const std::filesystem::path& filename)
+{
+    if (!std::filesystem::exists(filename)) {
+        throw std::runtime_error("File could not be opened: " + filename.string());
+    }
+    if (std::filesystem::file_size(filename) == 0) {
+        return buildMesh({});
+    }
+
+    boost::iostreams::mapped_file_source file(filename.string());
+    if (!file.is_open()) {
+        throw std::runtime_error("File could not be opened: " + filename.string());
+    }
+
+    const char* data = file.data();
+    const std::size_t size = file.size();
+    if (isBinary(data, size)) {
+        return buildMesh(readBinaryVertices(data, size));
+    }
+    else {
+        return buildMesh(readASCIIVertices(data, size));
+    }
+}
+
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "types/Mesh.h"
+
+#include <filesystem>
+
+namespace meshlib::stlIO
+{
+    // Reads binary or ASCII STL files. Coincident vertices are merged and
+    // triangles which become degenerate after merging are discarded.
+    // All triangles are stored in a single group.
+    Mesh readSTL(const std::filesystem::path& fileName);
+}
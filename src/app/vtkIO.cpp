@@ -1,20 +1,31 @@
 #include "vtkIO.h"
+#include "stlIO.h"
 
 #include <vtksys/SystemTools.hxx>
 #include <vtkCellData.h>
 #include <vtkCellType.h>
-#include <vtkTriangle.h>
+#include <vtkCellArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdTypeArray.h>
+#include <vtkIntArray.h>
+#include <vtkTypeInt32Array.h>
+#include <vtkTypeInt64Array.h>
 #include <vtkQuad.h>
-#include <vtkLine.h>
-#include <vtkVertex.h>
+#include <vtkUnsignedCharArray.h>
 #include <vtkUnstructuredGrid.h>
 
+#include <vtkPolyData.h>
+
 #include <vtkAppendFilter.h>
 #include <vtkSTLReader.h>
 #include <vtkUnstructuredGridReader.h>
 #include <vtkPolyDataReader.h>
+#include <vtkXMLUnstructuredGridReader.h>
+#include <vtkXMLPolyDataReader.h>
 
 #include <vtkUnstructuredGridWriter.h>
+#include <vtkXMLUnstructuredGridWriter.h>
+#include <vtkXMLPolyDataWriter.h>
 
 const char* GROUPS_TAG_NAME = "group";
 
@@ -29,6 +40,14 @@ vtkSmartPointer<vtkUnstructuredGrid> vtkPolyDataToVTU(vtkPolyData* polyData)
     return appendFilter->GetOutput();
 }
 
+bool isXMLFile(const std::string& fn)
+{
+    std::ifstream inputStream(fn.c_str(), ios::in);
+    std::string header;
+    inputStream >> header;
+    return header.rfind("<?xml", 0) == 0 || header.rfind("<VTKFile", 0) == 0;
+}
+
 vtkSmartPointer<vtkUnstructuredGrid> readAsVTU(const std::filesystem::path& filename)
 {
     std::string fn = filename.string();
@@ -58,106 +77,190 @@ vtkSmartPointer<vtkUnstructuredGrid> readAsVTU(const std::filesystem::path& file
         reader->SetFileName(fn.c_str());
         reader->Update();
         vtu = vtkPolyDataToVTU(reader->GetOutput());
+    } else if (extension == ".vtu" && isXMLFile(fn)) {
+        vtkNew<vtkXMLUnstructuredGridReader> reader;
+        reader->SetFileName(fn.c_str());
+        reader->Update();
+        vtu = reader->GetOutput();
     } else if (extension == ".vtu") {
         vtkNew<vtkUnstructuredGridReader> reader;
         reader->SetFileName(fn.c_str());
         reader->Update();
         vtu = reader->GetOutput();
 
+    } else if (extension == ".vtp") {
+        vtkNew<vtkXMLPolyDataReader> reader;
+        reader->SetFileName(fn.c_str());
+        reader->Update();
+        vtu = vtkPolyDataToVTU(reader->GetOutput());
     } else {
         throw std::runtime_error("Unsupported file format");
     }
     return vtu;
 }
 
-Element vtkCellToElement(vtkCell* cell)
+Element::Type toElementType(unsigned char cellType)
 {
-    Element elem;
-    vtkVertex* vertex = nullptr;
-    vtkLine* line = nullptr;
-    vtkTriangle* triangle = nullptr;
-
-    switch (cell->GetCellType()) {
+    switch (cellType) {
     case VTK_VERTEX:
-        vertex = vtkVertex::SafeDownCast(cell);
-        elem.vertices = { CoordinateId(vertex->GetPointIds()->GetId(0)) };
-        elem.type = meshlib::Element::Type::Node;
-        break;
-    
+        return Element::Type::Node;
     case VTK_LINE:
-        line = vtkLine::SafeDownCast(cell);
-        elem.vertices = {
-            CoordinateId(line->GetPointIds()->GetId(0)),
-            CoordinateId(line->GetPointIds()->GetId(1))
-        };
-        elem.type = meshlib::Element::Type::Line;
-        break;
-
+        return Element::Type::Line;
     case VTK_TRIANGLE:
-        triangle = vtkTriangle::SafeDownCast(cell);
-        elem.vertices = {
-            CoordinateId(triangle->GetPointIds()->GetId(0)),
-            CoordinateId(triangle->GetPointIds()->GetId(1)),
-            CoordinateId(triangle->GetPointIds()->GetId(2))
-        };
-        elem.type = meshlib::Element::Type::Surface;
-        break;
+    case VTK_QUAD:
+        return Element::Type::Surface;
+    case VTK_TETRA:
+        return Element::Type::Volume;
+    default:
+        return Element::Type::None;
+    }
+}
+
+unsigned char toVTKCellType(const Element& elem)
+{
+    if (elem.isTriangle()) {
+        return VTK_TRIANGLE;
+    } else if (elem.isQuad()) {
+        return VTK_QUAD;
+    } else if (elem.isLine()) {
+        return VTK_LINE;
+    } else if (elem.isNode()) {
+        return VTK_VERTEX;
+    } else {
+        throw std::runtime_error("Unsupported element type");
+    }
+}
+
+Coordinates toCoordinates(vtkPoints* points)
+{
+    static_assert(sizeof(Coordinate) == 3 * sizeof(double), 
+        "Coordinate is expected to be stored as three contiguous doubles.");
+
+    if (points == nullptr) {
+        return {};
+    }
+
+    Coordinates res(points->GetNumberOfPoints());
+    auto doubles{ vtkDoubleArray::SafeDownCast(points->GetData()) };
+    if (res.empty()) {
+        return res;
+    } else if (doubles != nullptr) {
+        std::copy_n(doubles->GetPointer(0), 3 * res.size(), &res.front()[0]);
+    } else {
+        for (vtkIdType i = 0; i < points->GetNumberOfPoints(); i++) {
+            points->GetPoint(i, &res[i][0]);
+        }
+    }
+    return res;
+}
+
+// Offsets and connectivity are read from the cell array storage, which holds
+// 32 or 64 bit integers.
+template <class Id>
+void copyElements(
+    Mesh& mesh, vtkIdType nCells, 
+    const Id* offsets, const Id* connectivity,
+    const unsigned char* cellTypes, const int* groupIds)
+{
+    for (vtkIdType i = 0; i < nCells; i++) {
+        auto& elements{ mesh.groups[groupIds ? groupIds[i] : 0].elements };
+        auto type{ toElementType(cellTypes[i]) };
+        if (type == Element::Type::None) {
+            elements.emplace_back();
+        } else {
+            elements.emplace_back(
+                std::vector<CoordinateId>(connectivity + offsets[i], connectivity + offsets[i + 1]),
+                type);
+        }
     }
-    
-    return elem;
 }
 
 Mesh vtuToMesh(vtkUnstructuredGrid* vtu)
 {
     Mesh mesh;
+    mesh.coordinates = toCoordinates(vtu->GetPoints());
     
-    mesh.coordinates.reserve(vtu->GetNumberOfPoints());
-    for (vtkIdType i = 0; i < vtu->GetNumberOfPoints(); i++)
-    {
-        double p[3];
-        vtu->GetPoint(i, p);
-        Coordinate coord({p[0], p[1], p[2]});
-        mesh.coordinates.push_back(coord);
+    const vtkIdType nCells = vtu->GetNumberOfCells();
+    if (nCells == 0) {
+        mesh.groups.resize(1);
+        return mesh;
     }
 
+    vtkCellArray* cells = vtu->GetCells();
+    vtkUnsignedCharArray* cellTypesArray = vtu->GetCellTypesArray();
+    if (cells == nullptr || cellTypesArray == nullptr) {
+        throw std::runtime_error("Unstructured grid has no cells array.");
+    }
+    const unsigned char* cellTypes = cellTypesArray->GetPointer(0);
+
+    const int* groupIds = nullptr;
     if (vtu->GetCellData()->HasArray(GROUPS_TAG_NAME)) {
         vtkIntArray* groupsDataArray = 
             vtkIntArray::SafeDownCast(vtu->GetCellData()->GetArray(GROUPS_TAG_NAME));
-        mesh.groups.resize(groupsDataArray->GetRange()[1] + 1);
-        for (vtkIdType i = 0; i < vtu->GetNumberOfCells(); i++) {
-            auto g = groupsDataArray->GetValue(i);
-            mesh.groups[g].elements.push_back(
-                vtkCellToElement(vtu->GetCell(i)));
+        if (groupsDataArray == nullptr) {
+            throw std::runtime_error("Groups array must contain integers.");
         }
+        mesh.groups.resize(std::size_t(groupsDataArray->GetRange()[1]) + 1);
+        groupIds = groupsDataArray->GetPointer(0);
     } else {
         mesh.groups.resize(1);
-        mesh.groups[0].elements.reserve(vtu->GetNumberOfCells());
-        for (vtkIdType i = 0; i < vtu->GetNumberOfCells(); i++) {
-            mesh.groups[0].elements.push_back(
-                vtkCellToElement(vtu->GetCell(i)));
+    }
+
+    std::vector<std::size_t> groupSizes(mesh.groups.size(), 0);
+    for (vtkIdType i = 0; i < nCells; i++) {
+        groupSizes[groupIds ? groupIds[i] : 0]++;
+    }
+    for (std::size_t g = 0; g < mesh.groups.size(); g++) {
+        mesh.groups[g].elements.reserve(groupSizes[g]);
+    }
+
+    if (cells->IsStorage64Bit()) {
+        vtkTypeInt64Array* offsets = cells->GetOffsetsArray64();
+        vtkTypeInt64Array* connectivity = cells->GetConnectivityArray64();
+        if (offsets == nullptr || connectivity == nullptr) {
+            throw std::runtime_error("Unstructured grid has invalid cells storage.");
         }
+        copyElements(mesh, nCells, 
+            offsets->GetPointer(0), connectivity->GetPointer(0), cellTypes, groupIds);
+    } else {
+        vtkTypeInt32Array* offsets = cells->GetOffsetsArray32();
+        vtkTypeInt32Array* connectivity = cells->GetConnectivityArray32();
+        if (offsets == nullptr || connectivity == nullptr) {
+            throw std::runtime_error("Unstructured grid has invalid cells storage.");
+        }
+        copyElements(mesh, nCells, 
+            offsets->GetPointer(0), connectivity->GetPointer(0), cellTypes, groupIds);
     }
 
     return mesh;
 }
 
+// Points wrap the coordinates storage, which must outlive them.
 vtkSmartPointer<vtkPoints> toVTKPoints(const std::vector<Coordinate>& coordinates)
 {
-    vtkNew<vtkPoints> points;
-    points->Allocate(coordinates.size());
-    for (const auto& coord : coordinates) {
-        points->InsertNextPoint(coord[0], coord[1], coord[2]);
+    static_assert(sizeof(Coordinate) == 3 * sizeof(double), 
+        "Coordinate is expected to be stored as three contiguous doubles.");
+
+    vtkNew<vtkDoubleArray> data;
+    data->SetNumberOfComponents(3);
+    if (!coordinates.empty()) {
+        const int doNotDelete = 1;
+        data->SetArray(
+            const_cast<double*>(&coordinates.front()[0]), 3 * coordinates.size(), doNotDelete);
     }
+
+    vtkNew<vtkPoints> points;
+    points->SetData(data);
     return points;
 }   
 
 vtkSmartPointer<vtkIntArray> toVTKGroupsArray(const Mesh& mesh)
 {
     vtkNew<vtkIntArray> groupsDataArray;
-    for (auto g = 0; g < mesh.groups.size(); g++) {
-        for (auto e = 0; e < mesh.groups[g].elements.size(); e++) {
-            groupsDataArray->InsertNextValue( int(g) );
-        }
+    groupsDataArray->SetNumberOfValues(mesh.countElems());
+    int* groupIds = groupsDataArray->GetPointer(0);
+    for (std::size_t g = 0; g < mesh.groups.size(); g++) {
+        groupIds = std::fill_n(groupIds, mesh.groups[g].elements.size(), int(g));
     }
     groupsDataArray->SetName(GROUPS_TAG_NAME);
     return groupsDataArray;
@@ -170,39 +273,110 @@ vtkSmartPointer<vtkUnstructuredGrid> elementsToVTU(const Mesh& mesh)
     vtu->SetPoints(toVTKPoints(mesh.coordinates));
     vtu->GetCellData()->AddArray(toVTKGroupsArray(mesh));
 
-    std::vector<int> cellTypes;
-    cellTypes.reserve(mesh.countElems());
+    const vtkIdType nCells = mesh.countElems();
+    vtkIdType connectivitySize = 0;
+    for (const auto& group : mesh.groups) {
+        for (const auto& elem : group.elements) {
+            connectivitySize += elem.vertices.size();
+        }
+    }
+
+    vtkNew<vtkUnsignedCharArray> cellTypesArray;
+    vtkNew<vtkIdTypeArray> offsetsArray;
+    vtkNew<vtkIdTypeArray> connectivityArray;
+    cellTypesArray->SetNumberOfValues(nCells);
+    offsetsArray->SetNumberOfValues(nCells + 1);
+    connectivityArray->SetNumberOfValues(connectivitySize);
+
+    unsigned char* cellTypes = cellTypesArray->GetPointer(0);
+    vtkIdType* offsets = offsetsArray->GetPointer(0);
+    vtkIdType* connectivity = connectivityArray->GetPointer(0);
+    vtkIdType offset = 0;
+    for (const auto& group : mesh.groups) {
+        for (const auto& elem : group.elements) {
+            *cellTypes++ = toVTKCellType(elem);
+            *offsets++ = offset;
+            connectivity = std::copy(elem.vertices.begin(), elem.vertices.end(), connectivity);
+            offset += elem.vertices.size();
+        }
+    }
+    *offsets = offset;
+
     vtkNew<vtkCellArray> vtkCells;
-    vtkCells->Allocate(mesh.countElems());
+    vtkCells->SetData(offsetsArray, connectivityArray);
+    vtu->SetCells(cellTypesArray, vtkCells);
+
+    return vtu;
+}
+
+vtkSmartPointer<vtkCellArray> toVTKCellArray(
+    const Mesh& mesh, 
+    const std::function<bool(const Element&)>& condition, 
+    vtkIntArray* groupsDataArray)
+{
+    vtkIdType nCells = 0;
+    vtkIdType connectivitySize = 0;
     for (const auto& group : mesh.groups) {
         for (const auto& elem : group.elements) {
-            vtkSmartPointer<vtkCell> cell;
-            if (elem.isTriangle()) {
-                cellTypes.push_back(VTK_TRIANGLE);
-                cell = vtkSmartPointer<vtkTriangle>::New();
-            } else if (elem.isQuad()) {
-                cellTypes.push_back(VTK_QUAD);
-                cell = vtkSmartPointer<vtkQuad>::New();
-            } else if (elem.isLine()) {
-                cellTypes.push_back(VTK_LINE);
-                cell = vtkSmartPointer<vtkLine>::New();
-            } else if (elem.isNode()) {
-                cellTypes.push_back(VTK_VERTEX);
-                cell = vtkSmartPointer<vtkVertex>::New();
-            } else {
-                throw std::runtime_error("Unsupported element type");
+            if (condition(elem)) {
+                nCells++;
+                connectivitySize += elem.vertices.size();
+            }
+        }
+    }
+
+    vtkNew<vtkIdTypeArray> offsetsArray;
+    vtkNew<vtkIdTypeArray> connectivityArray;
+    offsetsArray->SetNumberOfValues(nCells + 1);
+    connectivityArray->SetNumberOfValues(connectivitySize);
+
+    vtkIdType* offsets = offsetsArray->GetPointer(0);
+    vtkIdType* connectivity = connectivityArray->GetPointer(0);
+    vtkIdType offset = 0;
+    for (std::size_t g = 0; g < mesh.groups.size(); g++) {
+        for (const auto& elem : mesh.groups[g].elements) {
+            if (!condition(elem)) {
+                continue;
             }
-            vtkIdType id = 0;
-            for (const auto& vId : elem.vertices) {
-                cell->GetPointIds()->SetId(id++, vId);
+            *offsets++ = offset;
+            connectivity = std::copy(elem.vertices.begin(), elem.vertices.end(), connectivity);
+            offset += elem.vertices.size();
+            groupsDataArray->InsertNextValue(int(g));
+        }
+    }
+    *offsets = offset;
+
+    vtkNew<vtkCellArray> cells;
+    cells->SetData(offsetsArray, connectivityArray);
+    return cells;
+}
+
+vtkSmartPointer<vtkPolyData> elementsToVTP(const Mesh& mesh)
+{
+    for (const auto& group : mesh.groups) {
+        for (const auto& elem : group.elements) {
+            if (!elem.isNode() && !elem.isLine() && !elem.isTriangle() && !elem.isQuad()) {
+                throw std::runtime_error("Unsupported element type");
             }
-            vtkCells->InsertNextCell(cell);
         }
     }
 
-    vtu->SetCells(cellTypes.data(), vtkCells);
+    vtkNew<vtkPolyData> vtp;
+    vtp->SetPoints(toVTKPoints(mesh.coordinates));
 
-    return vtu;
+    // Poly data cells are ordered as vertices, lines and polygons.
+    vtkNew<vtkIntArray> groupsDataArray;
+    groupsDataArray->Allocate(mesh.countElems());
+    groupsDataArray->SetName(GROUPS_TAG_NAME);
+    vtp->SetVerts(toVTKCellArray(mesh, 
+        [](const auto& e) { return e.isNode(); }, groupsDataArray));
+    vtp->SetLines(toVTKCellArray(mesh, 
+        [](const auto& e) { return e.isLine(); }, groupsDataArray));
+    vtp->SetPolys(toVTKCellArray(mesh, 
+        [](const auto& e) { return e.isTriangle() || e.isQuad(); }, groupsDataArray));
+    vtp->GetCellData()->AddArray(groupsDataArray);
+
+    return vtp;
 }
 
 vtkSmartPointer<vtkUnstructuredGrid> gridToVTU(const Grid& grid)
@@ -257,29 +431,96 @@ std::filesystem::path getFolder(const std::filesystem::path& fn)
 }
 
 Mesh readInputMesh(const std::filesystem::path& filename)
+{
+    std::string extension = filename.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                    ::tolower);
+    if (extension == ".stl") {
+        return stlIO::readSTL(filename);
+    }
+
+    return readInputMeshWithVTK(filename);
+}
+
+Mesh readInputMeshWithVTK(const std::filesystem::path& filename)
 {
     vtkSmartPointer<vtkUnstructuredGrid> vtu = readAsVTU(filename);
     return vtuToMesh(vtu);
 }
 
-void exportToVTU(const std::filesystem::path& filename, const vtkSmartPointer<vtkUnstructuredGrid>& vtu)
+void setCompression(vtkXMLWriter* writer, const Compression& compression)
+{
+    writer->SetDataModeToAppended();
+    writer->EncodeAppendedDataOff();
+    switch (compression) {
+    case Compression::None:
+        writer->SetCompressorTypeToNone();
+        break;
+    case Compression::ZLib:
+        writer->SetCompressorTypeToZLib();
+        break;
+    case Compression::LZ4:
+        writer->SetCompressorTypeToLZ4();
+        break;
+    }
+}
+
+void exportToVTU(
+    const std::filesystem::path& filename, 
+    const vtkSmartPointer<vtkUnstructuredGrid>& vtu, 
+    const Compression& compression)
 {
     std::string fn = filename.string();
-    vtkNew<vtkUnstructuredGridWriter> writer;
-    writer->SetFileName(fn.c_str());
-    writer->SetInputData(vtu);
+    std::string extension = vtksys::SystemTools::GetFilenameLastExtension(fn);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                    ::tolower);
+
+    if (extension == ".vtu") {
+        vtkNew<vtkXMLUnstructuredGridWriter> writer;
+        writer->SetFileName(fn.c_str());
+        writer->SetInputData(vtu);
+        setCompression(writer, compression);
+        writer->Write();
+    } else {
+        vtkNew<vtkUnstructuredGridWriter> writer;
+        writer->SetFileName(fn.c_str());
+        writer->SetInputData(vtu);
+        writer->Write();
+    }
+}
+
+void exportMeshToVTP(const std::filesystem::path& fn, const Mesh& mesh, const Compression& compression)
+{
+    vtkNew<vtkXMLPolyDataWriter> writer;
+    writer->SetFileName(fn.string().c_str());
+    writer->SetInputData(elementsToVTP(mesh));
+    setCompression(writer, compression);
     writer->Write();
 }
 
-void exportMeshToVTU(const std::filesystem::path& fn, const Mesh& mesh)
+void exportMeshToVTU(const std::filesystem::path& fn, const Mesh& mesh, const Compression& compression)
 {
-    exportToVTU(fn, elementsToVTU(mesh));
+    exportToVTU(fn, elementsToVTU(mesh), compression);
 }
 
-void exportGridToVTU(const std::filesystem::path& fn, const Grid& grid)
+void exportGridToVTU(const std::filesystem::path& fn, const Grid& grid, const Compression& compression)
 {
-    exportToVTU(fn, gridToVTU(grid));
+    exportToVTU(fn, gridToVTU(grid), compression);
 }
 
+Compression toCompression(const std::string& name)
+{
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "none") {
+        return Compression::None;
+    } else if (lower == "zlib") {
+        return Compression::ZLib;
+    } else if (lower == "lz4") {
+        return Compression::LZ4;
+    } else {
+        throw std::runtime_error("Unsupported compression: " + name);
+    }
+}
 
 }
@@ -6,12 +6,28 @@
 
 namespace meshlib::vtkIO
 {
+    // Compression of XML formats (.vtu, .vtp), which are written in binary appended mode.
+    // Legacy .vtk files are written uncompressed.
+    enum class Compression {
+        None,
+        ZLib,
+        LZ4
+    };
+
+    Compression toCompression(const std::string& name);
+
     std::string getBasename(const std::filesystem::path& fn);
     std::filesystem::path getFolder(const std::filesystem::path& fn);
     
     Mesh readInputMesh(const std::filesystem::path& fileName);
+    // Reads the file with the VTK readers, also for STL files, which
+    // readInputMesh reads natively.
+    Mesh readInputMeshWithVTK(const std::filesystem::path& fileName);
 
-    void exportMeshToVTP(const std::filesystem::path& fn, const Mesh& mesh);
-    void exportMeshToVTU(const std::filesystem::path& fn, const Mesh& mesh);
-    void exportGridToVTU(const std::filesystem::path& fn, const Grid& grid);
+    void exportMeshToVTP(const std::filesystem::path& fn, const Mesh& mesh, 
+        const Compression& compression = Compression::ZLib);
+    void exportMeshToVTU(const std::filesystem::path& fn, const Mesh& mesh, 
+        const Compression& compression = Compression::ZLib);
+    void exportGridToVTU(const std::filesystem::path& fn, const Grid& grid, 
+        const Compression& compression = Compression::ZLib);
 }
\ No newline at end of file
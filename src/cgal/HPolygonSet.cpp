@@ -201,6 +201,11 @@ HPolygonSet::HPolygonSet(const std::initializer_list<Point2>& ps)
 	*this = HPolygonSet(buildPolygon(ps));
 }
 
+HPolygonSet::HPolygonSet(const std::vector<PolygonPK>& ps)
+{
+	CGAL::Polygon_set_2<PK>::join(ps.begin(), ps.end());
+}
+
 void HPolygonSet::join(const Polygon& p)
 {
 	CGAL::Polygon_set_2<PK>::join(convertToLocalPolygon(p));
@@ -3,6 +3,9 @@
 #include "Types.h"
 
 #include <CGAL/Boolean_set_operations_2.h>
+#ifdef TESSELLATOR_USE_FILTERED_KERNEL
+#include <CGAL/Exact_predicates_exact_constructions_kernel.h>
+#endif
 
 namespace meshlib {
 namespace cgal {
@@ -16,8 +19,16 @@ using PolygonSet = CGAL::Polygon_set_2<K>;
 using Arrangement = PolygonSet::Arrangement_2;
 using Segment = PolygonSet::Arrangement_2::Traits_2::Segment_2;
 
+// Kernel used by HPolygonSet operations, which must be exact. The filtered one
+// evaluates predicates with intervals and only computes exact values when these
+// are not enough to decide, which is much faster than always using rationals.
+#ifdef TESSELLATOR_USE_FILTERED_KERNEL
+using PK = CGAL::Exact_predicates_exact_constructions_kernel;
+using PKType = PK::FT;
+#else
 using PKType = CGAL::Quotient<CGAL::MP_Float>;
 using PK = CGAL::Cartesian<PKType>;
+#endif
 using PolygonPK = CGAL::Polygon_2<PK>;
 
 Polygon buildPolygon(const std::initializer_list<Point2>);
@@ -31,6 +42,9 @@ public:
 	HPolygonSet(const Polygon&);
 	HPolygonSet(const PolygonPK&);
 	HPolygonSet(const std::initializer_list<Point2>&);
+	// Joins all polygons at once, which is faster than joining them one by one.
+	// Polygons must be simple and counterclockwise oriented.
+	HPolygonSet(const std::vector<PolygonPK>&);
 	
 	void join(const Polygon&);
 	void join(const HPolygonSet&);
@@ -0,0 +1,262 @@
+#include "DenseFillingStates.h"
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <stdexcept>
+
+namespace meshlib::cgal::filler {
+
+namespace {
+
+const char MAGIC[8] = { 'T', 'E', 'S', 'S', 'F', 'I', 'L', 'L' };
+const std::uint32_t VERSION = 1;
+
+const std::uint8_t EMPTY_CODE = 0;
+const std::uint8_t PARTIAL_CODE = 1;
+const std::uint8_t FIRST_FULL_CODE = 2;
+
+template <class T>
+void write(std::ostream& os, const T& v)
+{
+	os.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <class T>
+T read(std::istream& is)
+{
+	T res;
+	is.read(reinterpret_cast<char*>(&res), sizeof(T));
+	if (!is) {
+		throw std::runtime_error("Filling states file is truncated.");
+	}
+	return res;
+}
+
+std::array<std::size_t, 3> buildIndices(const CellIndex& c, bool isEdge)
+{
+	const auto x{ c.axis };
+	const auto y{ (x + 1) % 3 };
+	const auto z{ (x + 2) % 3 };
+	if (isEdge) {
+		return { std::size_t(c.ijk[y]), std::size_t(c.ijk[z]), std::size_t(c.ijk[x]) };
+	}
+	return { std::size_t(c.ijk[x]), std::size_t(c.ijk[y]), std::size_t(c.ijk[z]) };
+}
+
+bool isInside(const PackedFillingStates& a, const CellIndex& c, bool isEdge)
+{
+	for (auto d{ 0 }; d < 3; ++d) {
+		if (c.ijk[d] < 0) {
+			return false;
+		}
+	}
+	const auto idx{ buildIndices(c, isEdge) };
+	const auto& dims{ a.getDimensions() };
+	return idx[0] < dims[0] && idx[1] < dims[1] && idx[2] < dims[2];
+}
+
+void writeArray(std::ostream& os, const PackedFillingStates& a)
+{
+	for (const auto& n : a.getDimensions()) {
+		write(os, std::uint64_t(n));
+	}
+	write(os, std::uint64_t(a.getWordsPerRow()));
+	const auto& words{ a.getWords() };
+	os.write(
+		reinterpret_cast<const char*>(words.data()),
+		words.size() * sizeof(PackedFillingStates::Word));
+}
+
+// Dimensions are checked against the file size, so corrupted files cannot
+// trigger huge allocations.
+PackedFillingStates readArray(std::istream& is, std::size_t bitsPerEntry, std::uintmax_t fileSize)
+{
+	const std::uint64_t maxWords{ fileSize / sizeof(PackedFillingStates::Word) };
+	PackedFillingStates::Dimensions dims;
+	for (auto& n : dims) {
+		n = std::size_t(read<std::uint64_t>(is));
+		if (n > (std::uint64_t(1) << 24)) {
+			throw std::runtime_error("Invalid filling states file.");
+		}
+	}
+	const std::uint64_t entriesPerWord{ 64 / bitsPerEntry };
+	const std::uint64_t wordsPerRow{ (dims[1] * dims[2] + entriesPerWord - 1) / entriesPerWord };
+	if (dims[0] * wordsPerRow > maxWords) {
+		throw std::runtime_error("Filling states file is truncated.");
+	}
+	PackedFillingStates res(dims, bitsPerEntry);
+	if (read<std::uint64_t>(is) != res.getWordsPerRow()) {
+		throw std::runtime_error("Invalid filling states file.");
+	}
+	auto& words{ res.getWords() };
+	is.read(
+		reinterpret_cast<char*>(words.data()),
+		words.size() * sizeof(PackedFillingStates::Word));
+	if (!is) {
+		throw std::runtime_error("Filling states file is truncated.");
+	}
+	return res;
+}
+
+}
+
+PackedFillingStates::PackedFillingStates(const Dimensions& dims, std::size_t bitsPerEntry) :
+	dims_{ dims },
+	bitsPerEntry_{ bitsPerEntry }
+{
+	if (bitsPerEntry_ != 2 && bitsPerEntry_ != 4 && bitsPerEntry_ != 8) {
+		throw std::runtime_error("Unsupported bits per entry in filling states.");
+	}
+	const std::size_t entriesPerWord{ 64 / bitsPerEntry_ };
+	wordsPerRow_ = (dims_[1] * dims_[2] + entriesPerWord - 1) / entriesPerWord;
+	words_.assign(dims_[0] * wordsPerRow_, 0);
+}
+
+std::uint8_t PackedFillingStates::getCode(std::size_t n0, std::size_t n1, std::size_t n2) const
+{
+	assert(n0 < dims_[0] && n1 < dims_[1] && n2 < dims_[2]);
+	const std::size_t entry{ n1 * dims_[2] + n2 };
+	const std::size_t entriesPerWord{ 64 / bitsPerEntry_ };
+	const Word& w{ words_[n0 * wordsPerRow_ + entry / entriesPerWord] };
+	const std::size_t shift{ (entry % entriesPerWord) * bitsPerEntry_ };
+	const Word mask{ (Word(1) << bitsPerEntry_) - 1 };
+	return std::uint8_t((w >> shift) & mask);
+}
+
+void PackedFillingStates::setCode(std::size_t n0, std::size_t n1, std::size_t n2, std::uint8_t code)
+{
+	assert(n0 < dims_[0] && n1 < dims_[1] && n2 < dims_[2]);
+	const std::size_t entry{ n1 * dims_[2] + n2 };
+	const std::size_t entriesPerWord{ 64 / bitsPerEntry_ };
+	Word& w{ words_[n0 * wordsPerRow_ + entry / entriesPerWord] };
+	const std::size_t shift{ (entry % entriesPerWord) * bitsPerEntry_ };
+	const Word mask{ (Word(1) << bitsPerEntry_) - 1 };
+	w = (w & ~(mask << shift)) | ((Word(code) & mask) << shift);
+}
+
+bool PackedFillingStates::operator==(const PackedFillingStates& rhs) const
+{
+	return dims_ == rhs.dims_
+		&& bitsPerEntry_ == rhs.bitsPerEntry_
+		&& words_ == rhs.words_;
+}
+
+std::size_t getBitsPerEntry(std::size_t numberOfPriorities)
+{
+	for (std::size_t bits : { 2, 4, 8 }) {
+		if (FIRST_FULL_CODE + numberOfPriorities <= (std::size_t(1) << bits)) {
+			return bits;
+		}
+	}
+	throw std::runtime_error("Too many priorities to pack filling states.");
+}
+
+std::uint8_t DenseFillingStates::toCode(const FillingState& s) const
+{
+	if (s.empty()) {
+		return EMPTY_CODE;
+	}
+	if (s.partial()) {
+		return PARTIAL_CODE;
+	}
+	auto it{ std::find(priorities.begin(), priorities.end(), s.getPriority()) };
+	if (it == priorities.end()) {
+		throw std::runtime_error("Priority not found in filling states table.");
+	}
+	return std::uint8_t(FIRST_FULL_CODE + (it - priorities.begin()));
+}
+
+FillingState DenseFillingStates::fromCode(std::uint8_t code) const
+{
+	if (code == EMPTY_CODE) {
+		return { FillingType::Empty };
+	}
+	if (code == PARTIAL_CODE) {
+		return { FillingType::Partial };
+	}
+	return { priorities.at(code - FIRST_FULL_CODE) };
+}
+
+FillingState DenseFillingStates::getFaceFillingState(const CellIndex& c) const
+{
+	const auto& a{ faces[c.axis] };
+	if (!isInside(a, c, false)) {
+		return { FillingType::Empty };
+	}
+	const auto idx{ buildIndices(c, false) };
+	return fromCode(a.getCode(idx[0], idx[1], idx[2]));
+}
+
+FillingState DenseFillingStates::getEdgeFillingState(const CellIndex& c) const
+{
+	const auto& a{ edges[c.axis] };
+	if (!isInside(a, c, true)) {
+		return { FillingType::Empty };
+	}
+	const auto idx{ buildIndices(c, true) };
+	return fromCode(a.getCode(idx[0], idx[1], idx[2]));
+}
+
+void writeFillingStates(const std::filesystem::path& fileName, const DenseFillingStates& s)
+{
+	std::ofstream ofs(fileName, std::ios::binary);
+	if (!ofs) {
+		throw std::runtime_error("File could not be opened: " + fileName.string());
+	}
+	ofs.write(MAGIC, sizeof(MAGIC));
+	write(ofs, VERSION);
+	write(ofs, std::uint32_t(s.faces[X].getBitsPerEntry()));
+	write(ofs, std::uint64_t(s.priorities.size()));
+	for (const auto& pr : s.priorities) {
+		write(ofs, std::int32_t(pr));
+	}
+	if (s.priorities.size() % 2 != 0) {
+		write(ofs, std::int32_t(0));
+	}
+	for (const auto& a : s.faces) {
+		writeArray(ofs, a);
+	}
+	for (const auto& a : s.edges) {
+		writeArray(ofs, a);
+	}
+	if (!ofs) {
+		throw std::runtime_error("File could not be written: " + fileName.string());
+	}
+}
+
+DenseFillingStates readFillingStates(const std::filesystem::path& fileName)
+{
+	std::ifstream ifs(fileName, std::ios::binary);
+	if (!ifs) {
+		throw std::runtime_error("File could not be opened: " + fileName.string());
+	}
+	char magic[sizeof(MAGIC)];
+	ifs.read(magic, sizeof(magic));
+	if (!ifs || !std::equal(magic, magic + sizeof(magic), MAGIC) || read<std::uint32_t>(ifs) != VERSION) {
+		throw std::runtime_error("File is not a supported filling states file: " + fileName.string());
+	}
+
+	const auto fileSize{ std::filesystem::file_size(fileName) };
+	DenseFillingStates res;
+	const std::size_t bitsPerEntry{ read<std::uint32_t>(ifs) };
+	const std::uint64_t numberOfPriorities{ read<std::uint64_t>(ifs) };
+	if (numberOfPriorities > 254 || getBitsPerEntry(numberOfPriorities) > bitsPerEntry) {
+		throw std::runtime_error("Invalid filling states file: " + fileName.string());
+	}
+	for (std::uint64_t i{ 0 }; i < numberOfPriorities; ++i) {
+		res.priorities.push_back(Priority(read<std::int32_t>(ifs)));
+	}
+	if (numberOfPriorities % 2 != 0) {
+		read<std::int32_t>(ifs);
+	}
+	for (auto& a : res.faces) {
+		a = readArray(ifs, bitsPerEntry, fileSize);
+	}
+	for (auto& a : res.edges) {
+		a = readArray(ifs, bitsPerEntry, fileSize);
+	}
+	return res;
+}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Slice.h"
+
+#include <cstdint>
+#include <filesystem>
+
+namespace meshlib::cgal::filler {
+
+// Filling states of a 3D array of faces or edges, packed with a few bits per
+// entry. Entries are indexed as (n0, n1, n2), with n0 the outermost dimension.
+// Each n0 row starts in a new 64-bit word so that rows can be written from
+// different threads. Codes are 0 for empty, 1 for partial and 2 + p for full
+// with the p-th priority of the priority table.
+class PackedFillingStates {
+public:
+	using Dimensions = std::array<std::size_t, 3>;
+	using Word = std::uint64_t;
+
+	PackedFillingStates() = default;
+	PackedFillingStates(const Dimensions&, std::size_t bitsPerEntry);
+
+	std::uint8_t getCode(std::size_t n0, std::size_t n1, std::size_t n2) const;
+	void setCode(std::size_t n0, std::size_t n1, std::size_t n2, std::uint8_t code);
+
+	const Dimensions& getDimensions() const { return dims_; }
+	std::size_t getBitsPerEntry() const { return bitsPerEntry_; }
+	std::size_t getWordsPerRow() const { return wordsPerRow_; }
+	const std::vector<Word>& getWords() const { return words_; }
+	std::vector<Word>& getWords() { return words_; }
+
+	bool operator==(const PackedFillingStates&) const;
+
+private:
+	Dimensions dims_{ 0, 0, 0 };
+	std::size_t bitsPerEntry_{ 2 };
+	std::size_t wordsPerRow_{ 0 };
+	std::vector<Word> words_;
+};
+
+// Filling states of all faces and edges of the grid.
+// Faces normal to axis x are indexed as (ijk[x], ijk[x+1], ijk[x+2]), having as
+// many rows as grid planes along x and as many entries as cells in the others.
+// Edges along axis x are indexed as (ijk[x+1], ijk[x+2], ijk[x]).
+class DenseFillingStates {
+public:
+	std::vector<Priority> priorities;
+	std::array<PackedFillingStates, 3> faces;
+	std::array<PackedFillingStates, 3> edges;
+
+	FillingState getFaceFillingState(const CellIndex&) const;
+	FillingState getEdgeFillingState(const CellIndex&) const;
+
+	std::uint8_t toCode(const FillingState&) const;
+	FillingState fromCode(std::uint8_t) const;
+
+	bool operator==(const DenseFillingStates& rhs) const {
+		return priorities == rhs.priorities
+			&& faces == rhs.faces
+			&& edges == rhs.edges;
+	}
+};
+
+// Smallest number of bits per entry, among 2, 4 and 8, able to store the codes
+// for the given number of priorities.
+std::size_t getBitsPerEntry(std::size_t numberOfPriorities);
+
+// Binary file layout, with the byte order of the machine, in which all
+// blocks start at multiples of 8 bytes so that it can be memory-mapped:
+//   char[8]  "TESSFILL"
+//   uint32   version
+//   uint32   bits per entry
+//   uint64   number of priorities
+//   int32    priorities, padded with zeros to a multiple of 8 bytes
+//   6 times, for faces along X, Y, Z and then edges along X, Y, Z:
+//     uint64 n0, n1, n2
+//     uint64 words per row
+//     uint64 words[n0 * words per row]
+void writeFillingStates(const std::filesystem::path&, const DenseFillingStates&);
+DenseFillingStates readFillingStates(const std::filesystem::path&);
+
+}
@@ -1,14 +1,16 @@
 #include "Filler.h"
 
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-#include <execution>
-#endif
-
 #include "cgal/PolyhedronTools.h"
 #include "cgal/Tools.h"
 #include "cgal/Manifolder.h"
 
 #include "utils/MeshTools.h"
+#include "utils/Parallel.h"
+
+#include <algorithm>
+#include <future>
+#include <list>
+#include <mutex>
 
 #include <CGAL/AABB_tree.h>
 #include <CGAL/AABB_traits_3.h>
@@ -96,6 +98,21 @@ Polyline2 convertPolyline3ToPolyline2(const Polyline3& pl, const Axis& x)
 	return pg;
 }
 
+Polylines2 buildPlanePolylines(const PMSlicer& slicer, const Axis& x, const SliceNumber& i)
+{
+	Polylines2 res;
+	Polylines3 pl3s;
+	slicer(buildSlicingPlane(x, (Height)i), std::back_inserter(pl3s));
+	for (const auto& pl3 : pl3s) {
+		auto pl{ removeCollinears(convertPolyline3ToPolyline2(pl3, x)) };
+		if (pl.size() < 2) {
+			continue;
+		}
+		res.push_back(pl);
+	}
+	return res;
+}
+
 std::array<std::map<SliceNumber, Polylines2>, 3> 
 buildGridPlanesPolylines(const Polyhedron& m, const Grid& g)
 {
@@ -105,26 +122,20 @@ buildGridPlanesPolylines(const Polyhedron& m, const Grid& g)
 		return res;
 	}
 
+	// The tree is built before the axes are sliced in parallel, so that they
+	// only read it.
 	PMSlicerTree tree{ edges(m).first, edges(m).second, m };
+	tree.build();
 	PMSlicer slicer(m, tree);
 
 	const std::array<Axis, 3> axis{ X, Y, Z };
 
-	std::for_each(
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-		std::execution::par,
-#endif
-		axis.begin(), axis.end(),
+	utils::parallelForEach(axis.begin(), axis.end(),
 		[&](const auto& x) {
 			for (std::size_t i{ 0 }; i < g[x].size(); ++i) {
-				Polylines3 pl3s;
-				slicer(buildSlicingPlane(x, (Height)i), std::back_inserter(pl3s));
-				for (const auto& pl3 : pl3s) {
-					auto pl{ removeCollinears(convertPolyline3ToPolyline2(pl3, x)) };
-					if (pl.size() < 2) {
-						continue;
-					}
-					res[x][(int)i].push_back(pl);
+				auto pls{ buildPlanePolylines(slicer, x, (SliceNumber)i) };
+				if (!pls.empty()) {
+					res[x][(int)i] = std::move(pls);
 				}
 			}
 		}
@@ -143,11 +154,7 @@ void sliceNonAlignedByGrid(
 	const auto polyLines{ buildGridPlanesPolylines(m, g) };
 	const std::array<Axis, 3> axis{ X, Y, Z };
 
-	std::for_each(
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-		std::execution::par,
-#endif
-		axis.begin(), axis.end(),
+	utils::parallelForEach(axis.begin(), axis.end(),
 		[&](const auto& x) {
 			for (const auto& [i, lines] : polyLines[x]) {
 				if (mode == SlicingMode::Surface) {
@@ -240,11 +247,7 @@ void sliceAlignedByGrid(
 	auto polygons{ buildGridPlanesPolygons(makeFacesCCWOriented(m), g)};
 	const std::array<Axis, 3> axis{ X, Y, Z };
 
-	std::for_each(
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-		std::execution::par,
-#endif
-		axis.begin(), axis.end(),
+	utils::parallelForEach(axis.begin(), axis.end(),
 		[&](const auto& x) {
 			for (const auto& [i, polygon] : polygons[x]) {
 				slices[x][i].add(polygon, priority);
@@ -253,6 +256,160 @@ void sliceAlignedByGrid(
 	);
 }
 
+void buildSearchMaps(Slice& slice)
+{
+	slice.simplifySurfaces();
+	slice.buildTriangulations();
+	slice.buildSearchMap();
+	slice.cleanSurfaces();
+}
+
+// Slices built on demand from the polyhedrons of each priority. Slices are
+// built once even when requested concurrently and are kept in a LRU which
+// evicts them when their estimated memory exceeds the limit.
+class LazySlices {
+public:
+	LazySlices(const Grid& grid, std::size_t maxMemoryInBytes) :
+		grid_{ grid },
+		maxMemoryInBytes_{ maxMemoryInBytes }
+	{}
+
+	void addGroup(const Priority& pr, FillerPolyhedrons&& fP)
+	{
+		groups_.push_back(std::make_unique<GroupData>());
+		auto& g{ *groups_.back() };
+		g.priority = pr;
+		g.volumes = std::move(fP.volumes);
+		g.surfaces = std::move(fP.surfaces);
+		g.alignedPolygons = buildGridPlanesPolygons(makeFacesCCWOriented(fP.aligned), grid_);
+		g.volumesSlicer = buildSlicer(g.volumes, g.volumesTree);
+		g.surfacesSlicer = buildSlicer(g.surfaces, g.surfacesTree);
+	}
+
+	std::shared_ptr<const Slice> get(const GridPlane& plane)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		auto it{ entries_.find(plane) };
+		if (it != entries_.end()) {
+			lru_.splice(lru_.begin(), lru_, it->second.lruIt);
+			auto slice{ it->second.slice };
+			lock.unlock();
+			return slice.get();
+		}
+
+		std::promise<std::shared_ptr<const Slice>> promise;
+		lru_.push_front(plane);
+		entries_.emplace(plane, Entry{ promise.get_future().share(), 0, lru_.begin() });
+		lock.unlock();
+
+		std::shared_ptr<Slice> slice;
+		try {
+			slice = std::make_shared<Slice>();
+			buildSlice(*slice, plane);
+		}
+		catch (...) {
+			promise.set_exception(std::current_exception());
+			lock.lock();
+			auto failed{ entries_.find(plane) };
+			lru_.erase(failed->second.lruIt);
+			entries_.erase(failed);
+			throw;
+		}
+		promise.set_value(slice);
+
+		lock.lock();
+		auto& entry{ entries_.at(plane) };
+		entry.memoryInBytes = slice->getMemoryEstimate();
+		memoryInBytes_ += entry.memoryInBytes;
+		evict(plane);
+		return slice;
+	}
+
+private:
+	struct GroupData {
+		Priority priority;
+		Polyhedron volumes;
+		Polyhedron surfaces;
+		std::array<std::map<SliceNumber, HPolygonSet>, 3> alignedPolygons;
+		std::unique_ptr<PMSlicerTree> volumesTree;
+		std::unique_ptr<PMSlicerTree> surfacesTree;
+		std::unique_ptr<PMSlicer> volumesSlicer;
+		std::unique_ptr<PMSlicer> surfacesSlicer;
+	};
+
+	struct Entry {
+		std::shared_future<std::shared_ptr<const Slice>> slice;
+		std::size_t memoryInBytes;
+		std::list<GridPlane>::iterator lruIt;
+	};
+
+	Grid grid_;
+	std::size_t maxMemoryInBytes_;
+	std::vector<std::unique_ptr<GroupData>> groups_;
+
+	std::mutex mutex_;
+	std::map<GridPlane, Entry> entries_;
+	std::list<GridPlane> lru_;
+	std::size_t memoryInBytes_{ 0 };
+
+	static std::unique_ptr<PMSlicer> buildSlicer(
+		const Polyhedron& m,
+		std::unique_ptr<PMSlicerTree>& tree)
+	{
+		if (m.empty()) {
+			return nullptr;
+		}
+		tree = std::make_unique<PMSlicerTree>(edges(m).first, edges(m).second, m);
+		tree->build();
+		return std::make_unique<PMSlicer>(m, *tree);
+	}
+
+	void buildSlice(Slice& slice, const GridPlane& plane) const
+	{
+		const auto& [x, i] { plane };
+		for (const auto& g : groups_) {
+			if (g->volumesSlicer) {
+				auto lines{ buildPlanePolylines(*g->volumesSlicer, x, i) };
+				if (!lines.empty()) {
+					slice.addAsPolygon(lines, g->priority);
+				}
+			}
+			if (g->surfacesSlicer) {
+				auto lines{ buildPlanePolylines(*g->surfacesSlicer, x, i) };
+				if (!lines.empty()) {
+					slice.add(lines, g->priority);
+				}
+			}
+			auto it{ g->alignedPolygons[x].find(i) };
+			if (it != g->alignedPolygons[x].end()) {
+				slice.add(it->second, g->priority);
+			}
+		}
+		buildSearchMaps(slice);
+	}
+
+	// Evicts the least recently used built slices, other than the given one,
+	// until memory is below the limit. Slices in use are kept alive by their
+	// users and rebuilt if requested again.
+	void evict(const GridPlane& keep)
+	{
+		if (maxMemoryInBytes_ == 0) {
+			return;
+		}
+		auto it{ lru_.end() };
+		while (memoryInBytes_ > maxMemoryInBytes_ && it != lru_.begin()) {
+			--it;
+			auto entry{ entries_.find(*it) };
+			if (*it == keep || entry->second.memoryInBytes == 0) {
+				continue;
+			}
+			memoryInBytes_ -= entry->second.memoryInBytes;
+			entries_.erase(entry);
+			it = lru_.erase(it);
+		}
+	}
+};
+
 Priority Filler::getGroupPriority(const GroupId& gId) const
 {
 	if (gId < groupPriorities_.size()) {
@@ -368,22 +525,16 @@ void buildGridSlicesSearchMaps(Filler::GridSlices& gS)
 	}
 
 	log("Building slices search maps", 3); 
-	std::for_each(
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-		std::execution::par,
-#endif
-		gS.begin(), gS.end(),
-		[&](auto& axis) {
-			std::for_each(
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-				std::execution::par,
-#endif
-				axis.begin(), axis.end(),
-				[&](auto& slice) {
-					slice.second.buildSearchMap();
-					slice.second.cleanSurfaces();
-				}
-			);
+	std::vector<Slice*> allSlices;
+	for (auto& axis : gS) {
+		for (auto& slice : axis) {
+			allSlices.push_back(&slice.second);
+		}
+	}
+	utils::parallelForEach(allSlices.begin(), allSlices.end(),
+		[&](Slice* slice) {
+			slice->buildSearchMap();
+			slice->cleanSurfaces();
 		}
 	);
 }
@@ -508,7 +659,9 @@ FillerPolyhedrons buildFillerPolyhedrons(
 Filler::Filler(
 	const Mesh& volumeMesh,
 	const Mesh& surfaceMesh,
-	const std::vector<Priority>& groupPriorities)
+	const std::vector<Priority>& groupPriorities,
+	const FillerOptions& opts) :
+	fuseFillingCoordinates_{ opts.fuseMeshFillingCoordinates }
 {
 	utils::meshTools::checkNoNullAreasExist(volumeMesh);
 	utils::meshTools::checkNoNullAreasExist(surfaceMesh);
@@ -531,6 +684,10 @@ Filler::Filler(
 	auto sGroups{ sM.groups };
 	mergeGroupsWithSamePriority(vGroups, sGroups);
 
+	if (opts.lazySlices) {
+		lazySlices_ = std::make_unique<LazySlices>(grid_, opts.maxSlicesMemoryInBytes);
+	}
+
 	for (std::size_t gId{ 0 }; gId < vGroups.size(); ++gId) {
 		std::stringstream ss;
 		ss << "Building filler for group " << gId;
@@ -542,31 +699,111 @@ Filler::Filler(
 		};
 		const auto pr{ getGroupPriority(gId) };
 		
+		log("Building segments arrays", 2);
+		buildSegmentsArray(segmentsArray_, fP.aligned, grid_, pr);
+		buildSegmentsArray(segmentsArray_, fP.volumes, grid_, pr);
+
+		if (lazySlices_) {
+			log("Preparing lazy slicing", 2);
+			lazySlices_->addGroup(pr, std::move(fP));
+			continue;
+		}
 		log("Slicing volumes", 2);
 		sliceNonAlignedByGrid(slices_, fP.volumes, grid_, pr, SlicingMode::Volume);
 		log("Slicing surfaces", 2);
 		sliceNonAlignedByGrid(slices_, fP.surfaces, grid_, pr, SlicingMode::Surface);
 		log("Slicing aligned", 2);
 		sliceAlignedByGrid(slices_, fP.aligned, grid_, pr);
-		log("Building segments arrays", 2);
-		buildSegmentsArray(segmentsArray_, fP.aligned, grid_, pr);
-		buildSegmentsArray(segmentsArray_, fP.volumes, grid_, pr);
 	}
-	log("Building slices search maps", 2);
-	buildGridSlicesSearchMaps(slices_);
+	if (!lazySlices_) {
+		log("Building slices search maps", 2);
+		buildGridSlicesSearchMaps(slices_);
+	}
 	log("Filling finished");
 }
 
+Filler::Filler(Filler&&) = default;
+Filler& Filler::operator=(Filler&&) = default;
+Filler::~Filler() = default;
+
+std::vector<GridPlane> Filler::getSlicePlanes() const
+{
+	std::vector<GridPlane> res;
+	for (const auto& x : { X, Y, Z }) {
+		if (lazySlices_) {
+			for (std::size_t i{ 0 }; i < grid_[x].size(); ++i) {
+				res.push_back({ x, SliceNumber(i) });
+			}
+		}
+		else {
+			for (const auto& [i, slice] : slices_[x]) {
+				res.push_back({ x, i });
+			}
+		}
+	}
+	return res;
+}
+
+std::shared_ptr<const Slice> Filler::getSlice(const Axis& x, const SliceNumber& i) const
+{
+	if (lazySlices_) {
+		if (i < 0 || std::size_t(i) >= grid_[x].size()) {
+			return nullptr;
+		}
+		return lazySlices_->get({ x, i });
+	}
+	auto it{ slices_[x].find(i) };
+	if (it == slices_[x].end()) {
+		return nullptr;
+	}
+	// Slices built in the constructor live as long as the filler.
+	return std::shared_ptr<const Slice>(std::shared_ptr<const Slice>(), &it->second);
+}
+
 FaceFilling Filler::getFaceFilling(const CellIndex& c) const
 {
 	//assert(getFillingState(c).partial());
-	auto it{ slices_[c.axis].find(c.getSliceNumber()) };
-	if (it != slices_[c.axis].end()) {
-		return it->second.getFaceFilling(c.getArrayIndex());
+	auto slice{ getSlice(c.axis, c.getSliceNumber()) };
+	if (slice) {
+		return slice->getFaceFilling(c.getArrayIndex());
 	}
 	return FaceFilling();
 }
 
+std::map<ArrayIndex, FaceFilling> Filler::getPartialFaceFillings(
+	const Axis& x, const SliceNumber& i) const
+{
+	auto slice{ getSlice(x, i) };
+	if (slice) {
+		return slice->getPartialFaceFillings();
+	}
+	return {};
+}
+
+std::vector<std::pair<CellIndex, FaceFilling>> Filler::getPartialFaceFillings() const
+{
+	const auto planes{ getSlicePlanes() };
+	std::vector<std::map<ArrayIndex, FaceFilling>> fillings(planes.size());
+	utils::parallelFor(0, planes.size(),
+		[&](std::size_t s) {
+			fillings[s] = getPartialFaceFillings(planes[s].first, planes[s].second);
+		}
+	);
+
+	std::vector<std::pair<CellIndex, FaceFilling>> res;
+	for (std::size_t s{ 0 }; s < planes.size(); ++s) {
+		const auto& [x, i] { planes[s] };
+		for (auto& [idx, ff] : fillings[s]) {
+			Cell c;
+			c[x] = i;
+			c[(x + 1) % 3] = idx[0];
+			c[(x + 2) % 3] = idx[1];
+			res.emplace_back(CellIndex{ c, x }, std::move(ff));
+		}
+	}
+	return res;
+}
+
 EdgeFilling Filler::getEdgeFilling(const CellIndex& c) const 
 {
 	if (segmentsArray_[c.axis].empty()) {
@@ -581,13 +818,110 @@ EdgeFilling Filler::getEdgeFilling(const CellIndex& c) const
 
 FillingState Filler::getFillingState(const CellIndex& c) const
 {
-	auto it{ slices_[c.axis].find(c.getSliceNumber())};
-	if (it == slices_[c.axis].end()) {
+	auto slice{ getSlice(c.axis, c.getSliceNumber()) };
+	if (!slice) {
 		return { FillingType::Empty };
 	}
 	else {
-		return it->second.getFillingState(c.getArrayIndex());
+		return slice->getFillingState(c.getArrayIndex());
+	}
+}
+
+FillingState buildEdgeFillingState(const EdgeFilling& ef, const CellDir& c)
+{
+	if (ef.lins.empty()) {
+		return { FillingType::Empty };
+	}
+	const Segment1 edge{ (KType) c, (KType) c + 1 };
+	if (ef.lins.size() == 1) {
+		const auto& [pr, segs] { *ef.lins.begin() };
+		if (segs.size() == 1 && segs.front() == edge) {
+			return { pr };
+		}
+	}
+	return { FillingType::Partial };
+}
+
+std::size_t numberOfCells(const std::vector<CoordinateDir>& planes)
+{
+	return planes.empty() ? 0 : planes.size() - 1;
+}
+
+DenseFillingStates Filler::getDenseFillingStates() const
+{
+	DenseFillingStates res;
+	const std::set<Priority> prs{ groupPriorities_.begin(), groupPriorities_.end() };
+	res.priorities.assign(prs.begin(), prs.end());
+	const auto bits{ getBitsPerEntry(res.priorities.size()) };
+	for (const auto& x : { X, Y, Z }) {
+		const auto y{ (x + 1) % 3 };
+		const auto z{ (x + 2) % 3 };
+		res.faces[x] = PackedFillingStates(
+			{ grid_[x].size(), numberOfCells(grid_[y]), numberOfCells(grid_[z]) }, bits);
+		res.edges[x] = PackedFillingStates(
+			{ grid_[y].size(), grid_[z].size(), numberOfCells(grid_[x]) }, bits);
+	}
+
+	// Slices and rows of edges write to different words, so they are filled
+	// in parallel. Only non-empty entries are written.
+	const auto planes{ getSlicePlanes() };
+	utils::parallelFor(0, planes.size(),
+		[&](std::size_t s) {
+			const auto& [x, i] { planes[s] };
+			auto& faces{ res.faces[x] };
+			const auto& dims{ faces.getDimensions() };
+			if (i < 0 || std::size_t(i) >= dims[0]) {
+				return;
+			}
+			auto slice{ getSlice(x, i) };
+			for (const auto& [idx, state] : slice->getNonEmptyFillingStates()) {
+				if (idx[0] < 0 || idx[1] < 0 ||
+					std::size_t(idx[0]) >= dims[1] || std::size_t(idx[1]) >= dims[2]) {
+					continue;
+				}
+				faces.setCode(i, idx[0], idx[1], res.toCode(state));
+			}
+		}
+	);
+
+	struct EdgeLine {
+		Axis x;
+		ArrayIndex idx;
+		const Segments* segments;
+	};
+	std::vector<std::vector<EdgeLine>> edgeRows;
+	for (const auto& x : { X, Y, Z }) {
+		for (const auto& [idx, segments] : segmentsArray_[x]) {
+			if (edgeRows.empty() || 
+				edgeRows.back().front().x != x || 
+				edgeRows.back().front().idx[0] != idx[0]) {
+				edgeRows.emplace_back();
+			}
+			edgeRows.back().push_back({ x, idx, &segments });
+		}
 	}
+	utils::parallelFor(0, edgeRows.size(),
+		[&](std::size_t r) {
+			for (const auto& line : edgeRows[r]) {
+				auto& edges{ res.edges[line.x] };
+				const auto& dims{ edges.getDimensions() };
+				if (line.idx[0] < 0 || line.idx[1] < 0 ||
+					std::size_t(line.idx[0]) >= dims[0] || std::size_t(line.idx[1]) >= dims[1]) {
+					continue;
+				}
+				for (std::size_t i{ 0 }; i < dims[2]; ++i) {
+					const auto state{ 
+						buildEdgeFillingState(line.segments->getEdgeFilling(CellDir(i)), CellDir(i)) 
+					};
+					if (!state.empty()) {
+						edges.setCode(line.idx[0], line.idx[1], i, res.toCode(state));
+					}
+				}
+			}
+		}
+	);
+
+	return res;
 }
 
 Elements buildTriangleElements(Coordinates& cs, const TriVs tris) 
@@ -622,44 +956,120 @@ Elements buildLineElements(Coordinates& cs, const LinVs lins)
 	return r;
 }
 
-void insertElementsInGroup(Group& g, const Elements& es)
+std::size_t hashCoordinate(const Coordinate& c)
 {
-	g.elements.insert(
-		g.elements.end(),
-		es.begin(), es.end()
-	);
+	std::size_t h{ 0 };
+	for (Axis d{ 0 }; d < 3; ++d) {
+		h = h * 31 + std::hash<Coordinate::Type>()(c[d]);
+	}
+	return h;
+}
+
+// Makes elements use the first coordinate with their position and removes the
+// others, keeping the order of the remaining ones. Coordinates are split in
+// buckets by a hash of their position, so that buckets are fused in parallel.
+void fuseFillingCoordinates(Mesh& m)
+{
+	const std::size_t n{ m.coordinates.size() };
+	const std::size_t nBuckets{ std::clamp<std::size_t>(n / 4096, 1, 1024) };
+	std::vector<std::size_t> bucketOf(n);
+	utils::parallelFor(0, n, [&](std::size_t id) {
+		bucketOf[id] = hashCoordinate(m.coordinates[id]) % nBuckets;
+	});
+	std::vector<CoordinateIds> buckets(nBuckets);
+	for (std::size_t id{ 0 }; id < n; ++id) {
+		buckets[bucketOf[id]].push_back(id);
+	}
+
+	CoordinateIds first(n);
+	utils::parallelFor(0, nBuckets, [&](std::size_t b) {
+		CoordinateMap firstAt;
+		for (const auto& id : buckets[b]) {
+			first[id] = firstAt.emplace(m.coordinates[id], id).first->second;
+		}
+	});
+
+	CoordinateIds newIds(n);
+	Coordinates fused;
+	for (std::size_t id{ 0 }; id < n; ++id) {
+		if (first[id] == id) {
+			newIds[id] = fused.size();
+			fused.push_back(m.coordinates[id]);
+		}
+	}
+	for (auto& g : m.groups) {
+		utils::parallelForEach(g.elements.begin(), g.elements.end(), [&](Element& e) {
+			for (auto& v : e.vertices) {
+				v = newIds[first[v]];
+			}
+		});
+	}
+	m.coordinates = std::move(fused);
 }
 
 Mesh Filler::getMeshFilling() const
 {
+	// Elements of each group and plane are built in parallel as chunks with
+	// their own coordinates. Each slice is visited once for all groups, so
+	// lazy slices are not built again for each group.
+	struct Chunk {
+		Elements elements;
+		Coordinates coordinates;
+	};
+	const auto planes{ getSlicePlanes() };
+	const std::size_t nGroups{ groupPriorities_.size() };
+	std::vector<Chunk> chunks(nGroups * planes.size());
+	utils::parallelFor(0, planes.size(), [&](std::size_t s) {
+		const auto& [x, i] { planes[s] };
+		auto slice{ getSlice(x, i) };
+		for (std::size_t gId{ 0 }; gId < nGroups; ++gId) {
+			const Priority pr{ getGroupPriority(gId) };
+			auto& chunk{ chunks[gId * planes.size() + s] };
+			chunk.elements = buildTriangleElements(chunk.coordinates, slice->buildAllTriVs(pr, x, (Height)i));
+			const auto lines{ buildLineElements(chunk.coordinates, slice->buildAllLinVs(pr, x, (Height)i)) };
+			chunk.elements.insert(chunk.elements.end(), lines.begin(), lines.end());
+		}
+	});
+
+	// Chunks are concatenated by group and plane, which is the order in which
+	// they would have been built serially.
 	Mesh m;
 	m.grid = grid_;
-	m.groups.resize(groupPriorities_.size());
-	for (auto gId{0}; gId < m.groups.size(); ++gId) {
-		for (const auto& x : { X, Y, Z }) {
-			for (const auto& [i, slice]: slices_[x]) {
-				const Priority pr{ getGroupPriority(gId) };
-				insertElementsInGroup(
-					m.groups[gId],
-					buildTriangleElements(
-						m.coordinates,
-						slice.buildAllTriVs(pr, x, (Height)i)
-					)
-				);
-				insertElementsInGroup(
-					m.groups[gId],
-					buildLineElements(
-						m.coordinates,
-						slice.buildAllLinVs(pr, x, (Height)i)
-					)
-				);
-
+	m.groups.resize(nGroups);
+	std::vector<std::size_t> coordinateOffsets(chunks.size());
+	std::vector<std::size_t> elementOffsets(chunks.size());
+	std::size_t numberOfCoordinates{ 0 };
+	for (std::size_t gId{ 0 }; gId < nGroups; ++gId) {
+		std::size_t numberOfElements{ 0 };
+		for (std::size_t s{ 0 }; s < planes.size(); ++s) {
+			const std::size_t c{ gId * planes.size() + s };
+			coordinateOffsets[c] = numberOfCoordinates;
+			elementOffsets[c] = numberOfElements;
+			numberOfCoordinates += chunks[c].coordinates.size();
+			numberOfElements += chunks[c].elements.size();
+		}
+		m.groups[gId].elements.resize(numberOfElements);
+	}
+	m.coordinates.resize(numberOfCoordinates);
+	utils::parallelFor(0, chunks.size(), [&](std::size_t c) {
+		auto& chunk{ chunks[c] };
+		std::copy(
+			chunk.coordinates.begin(), chunk.coordinates.end(), 
+			m.coordinates.begin() + coordinateOffsets[c]);
+		auto& elements{ m.groups[c / planes.size()].elements };
+		for (std::size_t e{ 0 }; e < chunk.elements.size(); ++e) {
+			for (auto& v : chunk.elements[e].vertices) {
+				v += coordinateOffsets[c];
 			}
+			elements[elementOffsets[c] + e] = std::move(chunk.elements[e]);
 		}
+	});
+
+	if (fuseFillingCoordinates_) {
+		fuseFillingCoordinates(m);
 	}
 
 	return m;
 }
 
-
 }
\ No newline at end of file
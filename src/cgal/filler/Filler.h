@@ -6,9 +6,27 @@
 
 #include "Slice.h"
 #include "SegmentsArray.h"
+#include "DenseFillingStates.h"
+
+#include <memory>
 
 namespace meshlib::cgal::filler {
 
+struct FillerOptions {
+	// Builds each slice on its first access instead of building all of them
+	// in the constructor. The sliced polyhedrons and their search trees are
+	// kept so that slices can be rebuilt after being evicted.
+	bool lazySlices = false;
+	// In lazy mode, the least recently used slices are evicted when the memory
+	// used by the built ones exceeds this size. Zero disables eviction.
+	std::size_t maxSlicesMemoryInBytes = 0;
+	// Fuses the coordinates of the mesh filling with the same position, which
+	// are otherwise repeated for each element.
+	bool fuseMeshFillingCoordinates = false;
+};
+
+class LazySlices;
+
 class Filler {
 public:
 	using Slices = std::map<SliceNumber, Slice>;
@@ -19,27 +37,43 @@ public:
 	Filler(
 		const Mesh& volumeMesh, 
 		const Mesh& surfaceMesh = Mesh(),
-		const std::vector<Priority>& groupPriorities = std::vector<Priority>());
+		const std::vector<Priority>& groupPriorities = std::vector<Priority>(),
+		const FillerOptions& opts = FillerOptions());
 	Filler(const Filler&) = delete;
-	Filler(Filler&&) = default;
+	Filler(Filler&&);
 	Filler& operator=(const Filler&) = delete;
-	Filler& operator=(Filler&&) = default;
-	~Filler() = default;
+	Filler& operator=(Filler&&);
+	~Filler();
 
 	EdgeFilling getEdgeFilling(const CellIndex&) const;
 	FaceFilling getFaceFilling(const CellIndex&) const;
+	// Fillings of all partial faces of a slice or of the whole grid, computed in
+	// bulk. Slices are processed in parallel.
+	std::map<ArrayIndex, FaceFilling> getPartialFaceFillings(const Axis&, const SliceNumber&) const;
+	std::vector<std::pair<CellIndex, FaceFilling>> getPartialFaceFillings() const;
 
 	FillingState getFillingState(const CellIndex&) const;
+	// States of all faces and edges of the grid, filled in parallel by slice.
+	DenseFillingStates getDenseFillingStates() const;
 	
+	// Elements are built in parallel by slice and concatenated in the order
+	// of groups and planes.
 	Mesh getMeshFilling() const;
 
 private:
 	GridSlices slices_;
+	std::unique_ptr<LazySlices> lazySlices_;
 	GridSegmentsArray segmentsArray_;
 	Grid grid_;
 	std::vector<Priority> groupPriorities_;
+	bool fuseFillingCoordinates_{ false };
 	Priority getGroupPriority(const GroupId& gId) const;
 
+	// Planes with a slice, which in lazy mode are all the grid planes.
+	std::vector<GridPlane> getSlicePlanes() const;
+	// Slice in a plane, which is null when there is none.
+	std::shared_ptr<const Slice> getSlice(const Axis&, const SliceNumber&) const;
+
 	void mergeGroupsWithSamePriority(Groups& vGroups, Groups& sGroups);
 
 };
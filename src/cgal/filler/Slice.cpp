@@ -441,6 +441,32 @@ void Slice::cleanSurfaces()
 	}
 }
 
+std::size_t Slice::getMemoryEstimate() const
+{
+	std::size_t res{ sizeof(Slice) };
+	res += nonEdgeAlignedContourIndices_.size() * 2 * sizeof(ArrayIndex);
+	for (const auto& [pr, sd] : data_) {
+		res += sizeof(SliceData);
+		for (const auto& l : sd.lines) {
+			res += sizeof(Polyline2) + l.size() * sizeof(Point2);
+		}
+		for (const auto& cdt : sd.triangulations) {
+			res += sizeof(CDT)
+				+ cdt.number_of_vertices() * sizeof(CDT::Vertex)
+				+ cdt.number_of_faces() * sizeof(CDT::Face);
+		}
+		for (const auto& [idx, faces] : sd.trianglesMaps) {
+			res += 2 * sizeof(ArrayIndex) + sizeof(faces) + faces.size() * sizeof(const CDT::Face*);
+		}
+		for (const auto& lineMap : sd.lineMaps) {
+			for (const auto& [idx, its] : lineMap) {
+				res += 2 * sizeof(ArrayIndex) + sizeof(its) + its.size() * sizeof(Polyline2::const_iterator);
+			}
+		}
+	}
+	return res;
+}
+
 void Slice::buildSearchMap() 
 {
 	for (auto& it : data_) {
@@ -484,6 +510,105 @@ void Slice::fillSurfaces(
 	}
 }
 
+using PointPK = CGAL::Point_2<PK>;
+using PointsPK = std::vector<PointPK>;
+
+// Splits a convex polygon by the line in which coordinate d is v, returning
+// the parts below and above it. Computed in the exact kernel, so that points
+// on the line are exactly on it.
+std::array<PointsPK, 2> splitConvexPolygon(const PointsPK& p, int d, const PKType& v)
+{
+	std::array<PointsPK, 2> res;
+	for (std::size_t i{ 0 }; i < p.size(); ++i) {
+		const auto& a{ p[i] };
+		const auto& b{ p[(i + 1) % p.size()] };
+		const auto sA{ CGAL::compare(a.cartesian(d), v) };
+		const auto sB{ CGAL::compare(b.cartesian(d), v) };
+		if (sA != CGAL::LARGER) {
+			res[0].push_back(a);
+		}
+		if (sA != CGAL::SMALLER) {
+			res[1].push_back(a);
+		}
+		if (sA != CGAL::EQUAL && sB != CGAL::EQUAL && sA != sB) {
+			const PKType t{ (v - a.cartesian(d)) / (b.cartesian(d) - a.cartesian(d)) };
+			const PKType w{ a.cartesian(1 - d) + t * (b.cartesian(1 - d) - a.cartesian(1 - d)) };
+			const PointPK q{ d == 0 ? PointPK{ v, w } : PointPK{ w, v } };
+			res[0].push_back(q);
+			res[1].push_back(q);
+		}
+	}
+	return res;
+}
+
+void addCellPiece(
+	std::map<ArrayIndex, std::vector<PolygonPK>>& pieces, 
+	const ArrayIndex& idx,
+	const PointsPK& ps)
+{
+	PolygonPK piece;
+	for (std::size_t i{ 0 }; i < ps.size(); ++i) {
+		if (ps[i] != ps[(i + 1) % ps.size()]) {
+			piece.push_back(ps[i]);
+		}
+	}
+	if (piece.size() >= 3 && CGAL::is_positive(piece.area())) {
+		pieces[idx].push_back(piece);
+	}
+}
+
+// Clips the triangle against the grid lines sweeping first along the first 
+// axis and then, for each column, along the second one. Pieces are stored by 
+// the cell face containing them.
+void clipTriangleByGrid(
+	const Triangle2& t, 
+	std::map<ArrayIndex, std::vector<PolygonPK>>& pieces)
+{
+	if (t.is_degenerate()) {
+		return;
+	}
+	CGAL::Cartesian_converter<K, PK> toLocal;
+	PointsPK rest;
+	for (int i{ 0 }; i < 3; ++i) {
+		rest.push_back(toLocal(t.vertex(i)));
+	}
+	if (t.orientation() == CGAL::CLOCKWISE) {
+		std::reverse(rest.begin(), rest.end());
+	}
+
+	const auto minMax{ buildMinAndMaxArrayIndices(t.bbox()) };
+	for (CellDir i{ minMax[0][0] }; i < minMax[1][0] && rest.size() >= 3; ++i) {
+		auto column{ splitConvexPolygon(rest, 0, PKType(i + 1)) };
+		rest = std::move(column[1]);
+		auto columnRest{ std::move(column[0]) };
+		for (CellDir j{ minMax[0][1] }; j < minMax[1][1] && columnRest.size() >= 3; ++j) {
+			auto row{ splitConvexPolygon(columnRest, 1, PKType(j + 1)) };
+			columnRest = std::move(row[1]);
+			addCellPiece(pieces, { i, j }, row[0]);
+		}
+	}
+}
+
+void Slice::fillAllSurfaces(std::map<ArrayIndex, FaceFilling>& r) const
+{
+	for (const auto& [pr, sd] : data_) {
+		std::map<ArrayIndex, std::vector<PolygonPK>> pieces;
+		for (const auto& triangulation : sd.triangulations) {
+			for (const auto& f : triangulation.finite_face_handles()) {
+				if (f->info().in_domain()) {
+					clipTriangleByGrid(buildTriangle2FromFace(*f), pieces);
+				}
+			}
+		}
+		for (const auto& [idx, ps] : pieces) {
+			auto it{ r.find(idx) };
+			if (it != r.end()) {
+				it->second.tris.emplace(pr, HPolygonSet(ps));
+			}
+		}
+	}
+}
+
 void Slice::fillLines(FaceFilling& r, const ArrayIndex& idx) const 
 {
 	auto cellFace{ buildCellFace(idx) };
@@ -518,6 +643,26 @@ FillingState Slice::getFillingState(const ArrayIndex& idx) const
 	return FillingState{ FillingType::Empty };
 }
 
+std::vector<std::pair<ArrayIndex, FillingState>> Slice::getNonEmptyFillingStates() const
+{
+	std::set<ArrayIndex> indices{ 
+		nonEdgeAlignedContourIndices_.begin(), 
+		nonEdgeAlignedContourIndices_.end() 
+	};
+	for (const auto& [pr, sd] : data_) {
+		for (const auto& [idx, faces] : sd.trianglesMaps) {
+			indices.insert(idx);
+		}
+	}
+
+	std::vector<std::pair<ArrayIndex, FillingState>> res;
+	res.reserve(indices.size());
+	for (const auto& idx : indices) {
+		res.emplace_back(idx, getFillingState(idx));
+	}
+	return res;
+}
+
 FaceFilling Slice::getFaceFilling(const ArrayIndex& idx) const
 {
 	FaceFilling res;
@@ -526,6 +671,19 @@ FaceFilling Slice::getFaceFilling(const ArrayIndex& idx) const
 	return res;
 }
 
+std::map<ArrayIndex, FaceFilling> Slice::getPartialFaceFillings() const
+{
+	std::map<ArrayIndex, FaceFilling> res;
+	for (const auto& idx : nonEdgeAlignedContourIndices_) {
+		res.emplace(idx, FaceFilling());
+	}
+	fillAllSurfaces(res);
+	for (auto& [idx, ff] : res) {
+		fillLines(ff, idx);
+	}
+	return res;
+}
+
 TriVs Slice::buildAllTriVs(const Priority& pr, Axis x, Height h) const
 {
 	TriVs res;
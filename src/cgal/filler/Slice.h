@@ -80,9 +80,14 @@ public:
 	Slice& operator=(const Slice&) = delete;
 
 	FaceFilling getFaceFilling(const ArrayIndex&) const;
+	// Fillings of all partial faces. Triangulations are clipped against the grid
+	// lines in a single sweep instead of intersecting each face on its own.
+	std::map<ArrayIndex, FaceFilling> getPartialFaceFillings() const;
 	LinVs buildAllLinVs(const Priority&, Axis, Height) const;
 	TriVs buildAllTriVs(const Priority&, Axis, Height) const;
 	FillingState getFillingState(const ArrayIndex&) const;
+	// States of all faces which are not empty, sorted by index.
+	std::vector<std::pair<ArrayIndex, FillingState>> getNonEmptyFillingStates() const;
 
 	void add(const Polylines2&, const Priority&);
 	void addAsPolygon(const Polylines2&, const Priority&);
@@ -92,6 +97,9 @@ public:
 	void buildTriangulations();
 	void simplifySurfaces();
 	void cleanSurfaces();
+
+	// Approximate number of bytes held by the slice.
+	std::size_t getMemoryEstimate() const;
 private:
 	struct SliceData {
 		Polylines2 lines;
@@ -113,6 +121,7 @@ private:
 	ContourIndexSet nonEdgeAlignedContourIndices_;
 		
 	void fillSurfaces(FaceFilling&, const ArrayIndex&) const;
+	void fillAllSurfaces(std::map<ArrayIndex, FaceFilling>&) const;
 	void fillLines(FaceFilling&, const ArrayIndex&) const;
 	void removeInSuperiorPriorities(const Priority& pr);
 };
@@ -11,7 +11,7 @@ namespace core {
 
 using namespace utils;
 
-Collapser::Collapser(const Mesh& in, int decimalPlaces)
+Collapser::Collapser(const Mesh& in, int decimalPlaces, ValidationLevel validation)
 {    
     mesh_ = in;
     double factor = std::pow(10.0, decimalPlaces);
@@ -24,7 +24,7 @@ Collapser::Collapser(const Mesh& in, int decimalPlaces)
     
     collapseDegenerateElements(mesh_, 0.4 / (factor * factor));
     RedundancyCleaner::removeOverlappedDimensionOneAndLowerElementsAndEquivalentSurfaces(mesh_);
-    utils::meshTools::checkNoNullAreasExist(mesh_);
+    utils::meshTools::checkNoNullAreasExist(mesh_, validation);
 }
 
 
@@ -38,10 +38,20 @@ void Collapser::collapseDegenerateElements(Mesh& mesh, const double& areaThresho
         ++iter) 
     {
         degeneratedTrianglesFound = false;
+        std::vector<bool> movedCoords(mesh.coordinates.size(), false);
         for (auto& group : mesh.groups) {
+            // Triangles with vertices moved earlier in this sweep are checked again.
+            const std::vector<bool> degenerate =
+                Geometry::areDegenerate(group.elements, mesh.coordinates, areaThreshold);
             for (auto& element : group.elements) {
-                if (!element.isTriangle() ||
-                    !Geometry::isDegenerate(Geometry::asTriV(element, mesh.coordinates), areaThreshold)) {
+                if (!element.isTriangle()) {
+                    continue;
+                }
+                const bool moved = std::any_of(element.vertices.begin(), element.vertices.end(),
+                    [&](auto const& v) { return movedCoords[v]; });
+                if (moved ? 
+                    !Geometry::isDegenerate(Geometry::asTriV(element, mesh.coordinates), areaThreshold) :
+                    !degenerate[&element - &group.elements.front()]) {
                     continue;
                 }
                 degeneratedTrianglesFound = true;
@@ -68,6 +78,7 @@ void Collapser::collapseDegenerateElements(Mesh& mesh, const double& areaThresho
                 else {
                     coords[element.vertices[midId]] = coords[element.vertices[(midId + 2) % 3]];
                 }
+                movedCoords[element.vertices[midId]] = true;
             }
         }
 
@@ -104,13 +115,10 @@ void Collapser::collapseDegenerateElements(Mesh& mesh, const double& areaThresho
     std::stringstream msg;
     bool breaksPostCondition = false;
     for (auto const& group : mesh.groups) {
+        const std::vector<bool> degenerate =
+            Geometry::areDegenerate(group.elements, mesh.coordinates, areaThreshold);
         for (auto const& element : group.elements) {
-            if (element.isNode() || element.isLine()) {
-                continue;
-            }
-
-            double area = Geometry::area(Geometry::asTriV(element, mesh.coordinates));
-            if (element.isTriangle() && area < areaThreshold) {
+            if (degenerate[&element - &group.elements.front()]) {
                 breaksPostCondition = true;
                 msg << std::endl;
                 msg << "Group: " << &group - &mesh.groups.front()
@@ -1,13 +1,17 @@
 #pragma once
 
 #include "types/Mesh.h"
+#include "utils/ValidationLevel.h"
 
 namespace meshlib {
 namespace core {
 
 class Collapser {
 public:
-	Collapser(const Mesh&, int decimalPlaces);
+	Collapser(
+		const Mesh&,
+		int decimalPlaces,
+		utils::ValidationLevel validation = utils::ValidationLevel::Full);
 
 	Mesh getMesh() const { return mesh_; }
 
@@ -6,9 +6,6 @@
 #include "utils/ConvexHull.h"
 #include "core/Collapser.h"
 
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-#include <execution>
-#endif
 
 namespace meshlib {
 namespace core {
@@ -61,9 +58,6 @@ Slicer::Slicer(const Mesh& input, const SlicerOptions& opts) :
 
     for (std::size_t g = 0; g < collapsed.groups.size(); g++) {
         std::for_each(
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-            std::execution::seq,
-#endif
             collapsed.groups[g].elements.begin(), collapsed.groups[g].elements.end(),
             [&](auto const& e) {
                 Elements elements;
@@ -101,8 +95,8 @@ Slicer::Slicer(const Mesh& input, const SlicerOptions& opts) :
     RedundancyCleaner::removeDegenerateElements(mesh_);
 
     // Checks ensured post conditions.
-    meshTools::checkNoCellsAreCrossed(mesh_);
-    meshTools::checkNoNullAreasExist(mesh_);
+    meshTools::checkNoCellsAreCrossed(mesh_, opts_.validation);
+    meshTools::checkNoNullAreasExist(mesh_, opts_.validation);
 }
 
 Elements Slicer::sliceTriangle(
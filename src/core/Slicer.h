@@ -5,12 +5,14 @@
 #include <mutex>
 
 #include "utils/GridTools.h"
+#include "utils/ValidationLevel.h"
 
 namespace meshlib {
 namespace core {
 
 struct SlicerOptions {
     int initialCollapsingDecimalPlaces = 4;
+    utils::ValidationLevel validation = utils::ValidationLevel::Full;
 };
 
 class Slicer : public utils::GridTools {
@@ -4,15 +4,12 @@
 #include "utils/Geometry.h"
 #include "utils/Tools.h"
 #include "utils/MeshTools.h"
+#include "utils/Parallel.h"
 #include "Collapser.h"
 
 #include <assert.h>
 #include <algorithm>
 
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-#include <execution>
-#endif
-
 namespace meshlib {
 namespace core {
 
@@ -24,7 +21,7 @@ Smoother::Smoother(const Mesh& mesh, const SmootherOptions& opts) :
     sT_(SmootherTools(mesh.grid)),
     opts_(opts)
 {
-    meshTools::checkNoCellsAreCrossed(mesh);
+    meshTools::checkNoCellsAreCrossed(mesh, opts_.validation);
 
     mesh_ = mesh;
     mesh_ = meshTools::duplicateCoordinatesUsedByDifferentGroups(mesh_);
@@ -32,17 +29,31 @@ Smoother::Smoother(const Mesh& mesh, const SmootherOptions& opts) :
     
     Mesh res = mesh_;
     for (auto& g : res.groups) {
+        const VoxelIndex index(sT_, g.elements, mesh_.coordinates);
         auto const singularIds = 
-            sT_.buildSingularIds(g.elements, mesh_.coordinates, opts_.featureDetectionAngle);
+            sT_.buildSingularIds(g.elements, mesh_.coordinates, index, opts_.featureDetectionAngle);
+
+        const auto cellElemMap = index.buildCellElemMap(g.elements);
+        std::vector<const ElementsView*> elemsInCells;
+        elemsInCells.reserve(cellElemMap.size());
+        for (auto const& cell : cellElemMap) {
+            elemsInCells.push_back(&cell.second);
+        }
+
+        std::vector<std::vector<ElementsView>> patchsInCells(elemsInCells.size());
+        parallelForEach(elemsInCells.begin(), elemsInCells.end(), [&](auto const& es) {
+            patchsInCells[&es - &elemsInCells.front()] =
+                Geometry::buildDisjointSmoothSets(*es, mesh_.coordinates, opts_.featureDetectionAngle);
+        });
 
         std::vector<ElementsView> patchs;
-        for (auto const& cell : sT_.buildCellElemMap(g.elements, mesh_.coordinates)) {
-            for (auto const& p :
-                Geometry::buildDisjointSmoothSets(cell.second, mesh_.coordinates, opts_.featureDetectionAngle)) {
-                patchs.push_back(p);
-            }
+        for (auto& patchsInCell : patchsInCells) {
+            std::move(patchsInCell.begin(), patchsInCell.end(), std::back_inserter(patchs));
         }
 
+        // Neighbouring patches share the coordinates on cell faces and edges,
+        // and each patch collapses them to positions moved by the previous
+        // ones, so patches are processed serially and in order.
         std::for_each(patchs.begin(), patchs.end(), [&](auto& p) {
             sT_.remeshBoundary(g.elements, res.coordinates, mesh_.coordinates, p);
         });
@@ -51,27 +62,15 @@ Smoother::Smoother(const Mesh& mesh, const SmootherOptions& opts) :
             sT_.collapsePointsOnCellEdges(res.coordinates, p, singularIds, opts_.contourAlignmentAngle);
         });
 
-        std::for_each(
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-            std::execution::par,
-#endif
-            patchs.begin(), patchs.end(), [&](auto& p) {
+        std::for_each(patchs.begin(), patchs.end(), [&](auto& p) {
             sT_.collapsePointsOnCellFaces(res.coordinates, p, singularIds);
         });
 
-        std::for_each(
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-            std::execution::par,
-#endif
-            patchs.begin(), patchs.end(), [&](auto& p) {
+        std::for_each(patchs.begin(), patchs.end(), [&](auto& p) {
             sT_.collapsePointsOnFeatureEdges(res.coordinates, p, singularIds);
         });
 
-        std::for_each(
-#ifdef TESSELLATOR_EXECUTION_POLICIES
-            std::execution::par,
-#endif      
-            patchs.begin(), patchs.end(), [&](auto& p) {
+        std::for_each(patchs.begin(), patchs.end(), [&](auto& p) {
             sT_.collapseInteriorPointsToBound(res.coordinates, p);
         });
 
@@ -91,7 +90,7 @@ Smoother::Smoother(const Mesh& mesh, const SmootherOptions& opts) :
     RedundancyCleaner::fuseCoords(mesh_);
     RedundancyCleaner::removeDegenerateElements(mesh_);
 
-    meshTools::checkNoCellsAreCrossed(mesh_);
+    meshTools::checkNoCellsAreCrossed(mesh_, opts_.validation);
 }
 
 }
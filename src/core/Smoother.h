@@ -3,6 +3,7 @@
 #include "SmootherTools.h"
 
 #include "types/Mesh.h"
+#include "utils/ValidationLevel.h"
 
 namespace meshlib {
 namespace core {
@@ -10,6 +11,7 @@ namespace core {
 struct SmootherOptions {
     double featureDetectionAngle = 30.0;
     double contourAlignmentAngle = 1.0;
+    utils::ValidationLevel validation = utils::ValidationLevel::Full;
 };
 
 class Smoother {
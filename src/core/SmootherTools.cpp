@@ -1,6 +1,7 @@
 #include "Smoother.h"
 
 #include "utils/CoordGraph.h"
+#include "utils/SmallCoordGraph.h"
 #include "utils/ElemGraph.h"
 #include "utils/RedundancyCleaner.h"
 #include "utils/Geometry.h"
@@ -62,8 +63,8 @@ void SmootherTools::collapsePointsOnFeatureEdges(
     const ElementsView& patch,
     const SingularIds& singularIds)
 {
-    CoordGraph Point = CoordGraph(patch);
-    CoordGraph edges = Point.getBoundaryGraph().intersect(singularIds.featureIds());
+    SmallCoordGraph Point = SmallCoordGraph(patch);
+    SmallCoordGraph edges = Point.getBoundaryGraph().intersect(singularIds.featureIds());
     if (edges.verticesSize() == 0) {
         return;
     }
@@ -138,13 +139,22 @@ SmootherTools::SingularIds SmootherTools::buildSingularIds(
     const Elements& elems,
     const Coordinates& coords,
     double smoothSetAngle) const
+{
+    return buildSingularIds(elems, coords, VoxelIndex(*this, elems, coords), smoothSetAngle);
+}
+
+SmootherTools::SingularIds SmootherTools::buildSingularIds(
+    const Elements& elems,
+    const Coordinates& coords,
+    const VoxelIndex& index,
+    double smoothSetAngle) const
 {
     IdSet featureIds, contourIds, cornerIds;
     
     contourIds = CoordGraph(elems).getBoundaryGraph().getVertices();
     
-    for (auto const& c : buildCellElemMap(elems, coords)) {
-        const std::vector<CoordGraph> graphs = CoordGraph::buildFromElementsViews(
+    for (auto const& c : index.buildCellElemMap(elems)) {
+        const std::vector<SmallCoordGraph> graphs = SmallCoordGraph::buildFromElementsViews(
             Geometry::buildDisjointSmoothSets(c.second, coords, smoothSetAngle));
 
         for (auto const& g : graphs) {
@@ -172,7 +182,7 @@ void SmootherTools::collapsePointsOnCellEdges(
     double alignmentAngle)
 {
     {
-        IdSet vertices = CoordGraph(patch).getVertices();
+        IdSet vertices = SmallCoordGraph(patch).getVertices();
 
         if (!std::all_of(
             vertices.begin(), vertices.end(),
@@ -191,7 +201,7 @@ void SmootherTools::collapsePointsOnCellEdges(
     
     auto const & protectedIds = singularIds.edgeIds();
     for (auto const& aEG : ElemGraph(lines, coords).splitByWeight(alignmentAngle)) {
-        CoordGraph cG(aEG.getAsElements(lines));
+        SmallCoordGraph cG(aEG.getAsElements(lines));
         IdSet interior = cG.getInterior();
         if (interior.empty()) {
             continue;
@@ -245,7 +255,7 @@ void SmootherTools::collapsePointsOnCellFaces(
 {
     std::map<CoordinateId, Coordinate> toMove;
     std::map <CoordGraph::Path, std::pair<IdSet, IdSet>> cyclesToValidOrOnFace;
-    for (auto const& cycle : CoordGraph(patch).getBoundaryGraph().findCycles()) {
+    for (auto const& cycle : SmallCoordGraph(patch).getBoundaryGraph().findCycles()) {
         cyclesToValidOrOnFace.emplace( 
             cycle,
             classifyIds(IdSet(cycle.begin(), cycle.end()),
@@ -288,7 +298,7 @@ bool SmootherTools::patchIsPlanar(
     const Coordinates& cs,
     const ElementsView& patch)
 {
-    IdSet bound = CoordGraph(patch).getBoundAndInteriorVertices().first;
+    IdSet bound = SmallCoordGraph(patch).getBoundAndInteriorVertices().first;
     Coordinates boundCs;
     boundCs.reserve(bound.size());
     for (const auto& id : bound) {
@@ -304,7 +314,7 @@ void SmootherTools::remeshBoundary(
     const Coordinates& meshCs,
     const ElementsView& patch)
 {
-    CoordGraph g(patch);
+    SmallCoordGraph g(patch);
     IdSet in = g.getBoundAndInteriorVertices().second;
     if (in.size() < 1) {
         return;
@@ -323,7 +333,7 @@ void SmootherTools::remeshWithNoInteriorPoints(
     const Coordinates& cs,
     const ElementsView& patch)
 {
-    CoordGraph g(patch);
+    SmallCoordGraph g(patch);
     IdSet in = g.getBoundAndInteriorVertices().second;
     if (in.size() < 1) {
         return;
@@ -369,7 +379,7 @@ void SmootherTools::remeshElementsToOneInteriorPoint(
     Coordinates& cs,
     const ElementsView& patch)
 {
-    CoordGraph g(patch);
+    SmallCoordGraph g(patch);
     IdSet bound, in;
     std::tie(bound, in) = g.getBoundAndInteriorVertices();
     
@@ -387,7 +397,7 @@ void SmootherTools::remeshElementsToOneInteriorPoint(
     }
     Elements remeshedElements;
 
-    for (Element line : CoordGraph(patch).getBoundaryGraph().getEdgesAsLines()) {
+    for (Element line : SmallCoordGraph(patch).getBoundaryGraph().getEdgesAsLines()) {
         line.type = Element::Type::Surface;
         line.vertices.push_back(uniqueId);
         remeshedElements.push_back(line);
@@ -453,13 +463,13 @@ Coordinates SmootherTools::collapsePointsOnContour(
     auto contourIds{ CoordGraph{ elems }.getBoundaryGraph().getVertices() };
     
     for (auto const& c : buildCellElemMap(elems, coords)) {
-        Elements lines = CoordGraph(c.second)
+        Elements lines = SmallCoordGraph(c.second)
             .getBoundaryGraph()
             .intersect(contourIds)
             .getEdgesAsLines();
 
         for (auto const& aEG : ElemGraph(lines, coords).splitByWeight(alignmentThresholdAngle)) {
-            CoordGraph cG(aEG.getAsElements(lines));
+            SmallCoordGraph cG(aEG.getAsElements(lines));
             IdSet validContourIds;
             try {
                 validContourIds = cG.getExterior();
@@ -488,7 +498,7 @@ void SmootherTools::collapseInteriorPointsToBound(
     const ElementsView& patch)
 {
     IdSet bound, interior;
-    std::tie(bound, interior) = CoordGraph(patch).getBoundAndInteriorVertices();
+    std::tie(bound, interior) = SmallCoordGraph(patch).getBoundAndInteriorVertices();
 
     std::map<CoordinateId, Coordinate> toMove;
     for (auto const& vI : interior) {
@@ -522,7 +532,7 @@ Elements SmootherTools::buildBoundaryContourAsLines(
     const Coordinates& coords,
     const ElementsView& patch) const
 {
-    CoordGraph g = CoordGraph(patch);
+    SmallCoordGraph g = SmallCoordGraph(patch);
     IdSet vertices = g.getVertices();
 
     IdSet contour = classifyIds(vertices, [&](auto i) {
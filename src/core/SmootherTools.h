@@ -3,6 +3,7 @@
 #include "utils/CoordGraph.h"
 #include "utils/GridTools.h"
 #include "utils/Tools.h"
+#include "utils/VoxelIndex.h"
 
 #include "types/Mesh.h"
 
@@ -67,6 +68,11 @@ public:
         const Elements& es,
         const Coordinates& cs,
         double smoothSetAngle) const;
+    SingularIds buildSingularIds(
+        const Elements& es,
+        const Coordinates& cs,
+        const utils::VoxelIndex& index,
+        double smoothSetAngle) const;
 
     void collapseInteriorPointsToBound(
         Coordinates& coords,
@@ -18,10 +18,10 @@ Snapper::Snapper(const Mesh& mesh, const SnapperOptions& opts) :
     }
     snap();
     
-    mesh_ = Collapser{mesh_, 4}.getMesh();
+    mesh_ = Collapser{mesh_, 4, opts_.validation}.getMesh();
 
-    utils::meshTools::checkNoCellsAreCrossed(mesh_);
-    utils::meshTools::checkNoNullAreasExist(mesh_);
+    utils::meshTools::checkNoCellsAreCrossed(mesh_, opts_.validation);
+    utils::meshTools::checkNoNullAreasExist(mesh_, opts_.validation);
 }
 
 std::pair<Coordinates, std::map<Coordinate, std::set<LinV>>> Snapper::buildListOfValidSolverPoints() const
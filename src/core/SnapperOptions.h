@@ -1,10 +1,15 @@
 #pragma once
 
+#include "utils/ValidationLevel.h"
+
+#include <cstddef>
+
 namespace meshlib::core {
 
 struct SnapperOptions {
 	double forbiddenLength{ 0.0 };
 	std::size_t edgePoints{ 0 };
+	utils::ValidationLevel validation{ utils::ValidationLevel::Full };
 };
 
 
@@ -1,6 +1,7 @@
 #include "Staircaser.h"
 
 #include "utils/RedundancyCleaner.h"
+#include "utils/VoxelIndex.h"
 
 #include <iostream>
 
@@ -57,52 +58,40 @@ CoordinateMap buildCoordinateMap(const Coordinates& cs)
     return res;
 }
 
-IdSet findCommonNeighborsVertices(const Mesh& mesh, const std::pair<CoordinateId, CoordinateId>& edge)
+IdSet findNeighborsOfVertex(
+    const GridTools& gridTools,
+    const Mesh& mesh,
+    const VoxelIndex& index,
+    const CoordinateId& vertex)
 {
-    IdSet commonNeighborsVertices;
-
-    const auto& vertex1 = edge.first;
-    const auto& vertex2 = edge.second;
-
-    GridTools gridTools;
-    auto cellElemMap = gridTools.buildCellElemMap(mesh.groups[0].elements, mesh.coordinates);
-    CoordinateMap coordinateMap = buildCoordinateMap(mesh.coordinates);
-
-    auto cellsCoord1 = gridTools.getTouchingCells(mesh.coordinates[vertex1]);
-    auto cellsCoord2 = gridTools.getTouchingCells(mesh.coordinates[vertex2]);
-
-    IdSet neighborsOfVertex1;
-    IdSet neighborsOfVertex2;
-
-    for (const auto& c : cellsCoord1) {
-        for (const auto& e : cellElemMap.at(c)) {
-            const auto& elementVertices = e->vertices;
-            auto it = std::find(elementVertices.begin(), elementVertices.end(), vertex1);
+    IdSet neighbors;
+    for (const auto& c : gridTools.getTouchingCells(mesh.coordinates[vertex])) {
+        for (const auto& eId : index.getElementIds(c)) {
+            const auto& elementVertices = mesh.groups[0].elements[eId].vertices;
+            auto it = std::find(elementVertices.begin(), elementVertices.end(), vertex);
 
             if (it != elementVertices.end()) {
                 auto pos = std::distance(elementVertices.begin(), it);
                 auto n = elementVertices.size();
 
-                neighborsOfVertex1.insert(elementVertices[(pos + n - 1) % n]); 
-                neighborsOfVertex1.insert(elementVertices[(pos + 1) % n]); 
-            }        
+                neighbors.insert(elementVertices[(pos + n - 1) % n]);
+                neighbors.insert(elementVertices[(pos + 1) % n]);
+            }
         }
     }
+    return neighbors;
+}
 
-    for (const auto& c : cellsCoord2) {
-        for (const auto& e : cellElemMap.at(c)) {
-            const auto& elementVertices = e->vertices;
-            auto it = std::find(elementVertices.begin(), elementVertices.end(), vertex2);
-
-            if (it != elementVertices.end()) {
-                auto pos = std::distance(elementVertices.begin(), it);
-                auto n = elementVertices.size();
+IdSet findCommonNeighborsVertices(
+    const GridTools& gridTools,
+    const Mesh& mesh,
+    const VoxelIndex& index,
+    const std::pair<CoordinateId, CoordinateId>& edge)
+{
+    IdSet commonNeighborsVertices;
 
-                neighborsOfVertex2.insert(elementVertices[(pos + n - 1) % n]); 
-                neighborsOfVertex2.insert(elementVertices[(pos + 1) % n]); 
-            }
-        }
-    }
+    IdSet neighborsOfVertex1 = findNeighborsOfVertex(gridTools, mesh, index, edge.first);
+    IdSet neighborsOfVertex2 = findNeighborsOfVertex(gridTools, mesh, index, edge.second);
 
     for (const auto& v : neighborsOfVertex1) {
         if (neighborsOfVertex2.count(v)) {
@@ -266,13 +255,19 @@ void Staircaser::fillGaps(const RelativePairSet boundaryCoordinatePairs) {
         uniqueElementsByVertices.insert(element.vertices);
     }
 
+    // Cells are not bounded by the grid, as they were when the cell map was
+    // built for every edge, so elements beyond its upper boundary are also found.
+    const GridTools unboundedGridTools;
+    // Gaps are filled in place, so the index is updated as triangles are added and removed.
+    VoxelIndex index(unboundedGridTools, mesh_.groups[0].elements, mesh_.coordinates);
+
     CoordinateMap coordinateMap = buildCoordinateMap(mesh_.coordinates);
     for (const auto& [coord1, coord2] : boundaryCoordinatePairs) {
         auto v1 = coordinateMap.at(coord1);
         auto v2 = coordinateMap.at(coord2);
         std::pair<CoordinateId, CoordinateId> edge = std::make_pair(v1, v2);
 
-        auto commonNeighbors = findCommonNeighborsVertices(mesh_, edge);
+        auto commonNeighbors = findCommonNeighborsVertices(unboundedGridTools, mesh_, index, edge);
 
         auto triangles = findTrianglesWithEdge(mesh_, edge);
         bool correctOrientation;
@@ -331,6 +326,7 @@ void Staircaser::fillGaps(const RelativePairSet boundaryCoordinatePairs) {
                 if (!elementAlreadyExists) {
                     std::swap(triangle.vertices[1], triangle.vertices[2]);
                     mesh_.groups[0].elements.push_back(triangle);
+                    index.insert(triangle, mesh_.coordinates);
                     uniqueElementsByVertices.insert(triangle.vertices);
                 }
             }
@@ -366,6 +362,8 @@ void Staircaser::fillGaps(const RelativePairSet boundaryCoordinatePairs) {
 
                     mesh_.groups[0].elements.push_back(triangle1);
                     mesh_.groups[0].elements.push_back(triangle2);
+                    index.insert(triangle1, mesh_.coordinates);
+                    index.insert(triangle2, mesh_.coordinates);
 
                     std::vector<IdSet> toRemove(mesh_.groups.size());
                     for (GroupId g = 0; g < mesh_.groups.size(); ++g) {
@@ -386,6 +384,7 @@ void Staircaser::fillGaps(const RelativePairSet boundaryCoordinatePairs) {
                     }
 
                     RedundancyCleaner::removeElements(mesh_, toRemove);
+                    index.erase(toRemove[0]);
                 }
             }
         } else {
@@ -8,7 +8,7 @@
 
 #include "utils/GridTools.h"
 #include "utils/MeshTools.h"
-#include "utils/CoordGraph.h"
+#include "utils/SmallCoordGraph.h"
 
 namespace meshlib::meshers {
 
@@ -62,7 +62,7 @@ std::size_t countPathsInCellBound(
     const ElementsView& elementsInCell,
     const std::pair<Axis, Side>& bound)
 {
-    auto cG = CoordGraph(elementsInCell);
+    auto cG = SmallCoordGraph(elementsInCell);
     auto vIds = cG.getVertices();
         
     std::size_t pathsInCellBound = 0;
@@ -82,7 +82,7 @@ std::size_t countPathsInCellBound(
     // Keep only edges if both vertices are in the cell bound.
     // Isolated vertices are not included.
     // Edges between two triangles are removed.
-    CoordGraph cellBoundGraph;
+    SmallCoordGraph cellBoundGraph;
     for (const auto& line: cG.getEdgesAsLines()) {
         const auto& v0 = line.vertices[0];
         const auto& v1 = line.vertices[1];
@@ -160,8 +160,25 @@ std::set<Cell> ConformalMesher::findNonConformalCells(const Mesh& mesh)
     return res;
 }
 
+CacheKey ConformalMesher::buildCacheKey(const Mesh& in, const ConformalMesherOptions& opts)
+{
+    CacheKey res("conformal");
+    res.add(in)
+        .add(opts.snapperOptions.forbiddenLength)
+        .add(opts.snapperOptions.edgePoints)
+        .add(opts.reorderSpatially)
+        .add(opts.volumeGroups);
+    return res;
+}
+
 Mesh ConformalMesher::mesh() const 
 {
+    if (cachedMesh_) {
+        return *cachedMesh_;
+    }
+
+    const ScopedExecution execution(opts_.execution);
+
     const auto slicingGrid{ buildSlicingGrid(originalGrid_, enlargedGrid_) };
     
     auto res = inputMesh_;
@@ -171,21 +188,40 @@ Mesh ConformalMesher::mesh() const
         return res;
     }
     
+    const StageCheckpoints checkpoints(
+        opts_.checkpoints,
+        "conformal",
+        opts_.checkpoints.isEnabled() ? buildCacheKey(inputMesh_, opts_) : CacheKey("conformal"),
+        { "slicing", "smoothing", "snapping" });
+
     log("Slicing.", 1);
     res.grid = slicingGrid;
-    res = Slicer{ res }.getMesh();
-        
+    checkpoints.run("slicing", res, [&](Mesh& m) {
+        SlicerOptions slicerOpts;
+        slicerOpts.validation = opts_.validation;
+        m = Slicer{ m, slicerOpts }.getMesh();
+        if (opts_.reorderSpatially) {
+            reorderSpatially(m);
+        }
+    });
     logNumberOfTriangles(countMeshElementsIf(res, isTriangle));
 
     log("Smoothing.", 1);
-    SmootherOptions smootherOpts;
-    smootherOpts.featureDetectionAngle = 30;
-    smootherOpts.contourAlignmentAngle = 0;
-    res = Smoother{res, smootherOpts}.getMesh();
+    checkpoints.run("smoothing", res, [&](Mesh& m) {
+        SmootherOptions smootherOpts;
+        smootherOpts.featureDetectionAngle = 30;
+        smootherOpts.contourAlignmentAngle = 0;
+        smootherOpts.validation = opts_.validation;
+        m = Smoother{ m, smootherOpts }.getMesh();
+    });
     logNumberOfTriangles(countMeshElementsIf(res, isTriangle));
     
     log("Snapping.", 1);
-    res = Snapper(res, opts_.snapperOptions).getMesh();
+    checkpoints.run("snapping", res, [&](Mesh& m) {
+        SnapperOptions snapperOpts = opts_.snapperOptions;
+        snapperOpts.validation = opts_.validation;
+        m = Snapper(m, snapperOpts).getMesh();
+    });
     logNumberOfTriangles(countMeshElementsIf(res, isTriangle));
 
     // Find cells which break conformal FDTD rules.
@@ -202,7 +238,7 @@ Mesh ConformalMesher::mesh() const
     // Converts relatives to absolutes.
     utils::meshTools::convertToAbsoluteCoordinates(res);
 
-
+    storeInCache(res);
     return res;
 }
 
@@ -13,10 +13,17 @@ public:
         inputMesh_{ in }, 
         opts_{opts},
         MesherBase(in)
-    {};
+    {
+        if (opts_.cache.isEnabled()) {
+            loadFromCache(opts_.cache, buildCacheKey(in, opts_));
+        }
+    };
     virtual ~ConformalMesher() = default;
     
     Mesh mesh() const;
+
+    // Key of the result for an input and options, as used by the cache.
+    static CacheKey buildCacheKey(const Mesh& in, const ConformalMesherOptions& opts);
     
     static std::set<Cell> findNonConformalCells(const Mesh& mesh);
     static std::set<Cell> cellsWithMoreThanAVertexInsideEdge(const Mesh& mesh);
@@ -0,0 +1,37 @@
+#include "IncrementalMesher.h"
+
+#include "utils/MeshTools.h"
+#include "utils/RedundancyCleaner.h"
+
+#include <stdexcept>
+
+namespace meshlib::meshers {
+
+using namespace utils;
+
+Mesh buildGroupInput(const Mesh& in, GroupId gId)
+{
+    Mesh res;
+    res.grid = in.grid;
+    res.coordinates = in.coordinates;
+    res.groups.push_back(in.groups.at(gId));
+    RedundancyCleaner::cleanCoords(res);
+    return res;
+}
+
+Mesh spliceGroups(const Grid& grid, const std::vector<Mesh>& groupMeshes)
+{
+    Mesh res;
+    res.grid = grid;
+    for (auto const& m : groupMeshes) {
+        if (m.groups.size() != 1 || m.grid != grid) {
+            throw std::runtime_error("Meshes to splice must have a single group and the same grid.");
+        }
+        meshTools::mergeMeshAsNewGroup(res, m);
+    }
+    RedundancyCleaner::fuseCoords(res);
+    RedundancyCleaner::cleanCoords(res);
+    return res;
+}
+
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "types/Mesh.h"
+#include "StageCheckpoints.h"
+
+#include <string>
+#include <vector>
+
+namespace meshlib::meshers {
+
+// Result of meshing each group on its own, which can be passed to the next
+// run to re-mesh only the groups whose input or options have changed.
+struct IncrementalResult {
+    Mesh mesh;
+    // Key of the input and options of each group and the mesh built from them.
+    std::vector<std::string> groupKeys;
+    std::vector<Mesh> groupMeshes;
+};
+
+// Input made only of one group of a mesh and the coordinates it uses, in the
+// same grid. Used coordinates keep their relative order.
+Mesh buildGroupInput(const Mesh& in, GroupId);
+
+// Joins meshes holding one group each in a mesh with as many groups.
+// Coordinates with the same position are fused.
+Mesh spliceGroups(const Grid&, const std::vector<Mesh>& groupMeshes);
+
+// Meshes each group of the input on its own with Mesher, which must provide a
+// static buildCacheKey(const Mesh&, const Options&). Groups whose key matches
+// the one in `previous` take their mesh from it instead of being meshed again,
+// and the others go through the result cache when it is enabled in the options.
+// Checkpoints are not written for the groups.
+// Groups are independent through all the stages except when they share
+// vertices: the Smoother fuses them and collapses contours on shared positions,
+// so such vertices can end slightly differently than in a single run.
+template <class Mesher, class Options>
+IncrementalResult meshIncrementally(
+    const Mesh& in,
+    const Options& opts,
+    const IncrementalResult& previous = IncrementalResult())
+{
+    IncrementalResult res;
+    res.groupKeys.resize(in.groups.size());
+    res.groupMeshes.resize(in.groups.size());
+    for (GroupId g = 0; g < in.groups.size(); g++) {
+        const Mesh groupIn = buildGroupInput(in, g);
+        Options groupOpts = opts;
+        groupOpts.volumeGroups.clear();
+        if (opts.volumeGroups.count(g)) {
+            groupOpts.volumeGroups.insert(0);
+        }
+        groupOpts.checkpoints = CheckpointOptions();
+
+        res.groupKeys[g] = Mesher::buildCacheKey(groupIn, groupOpts).toString();
+        if (g < previous.groupKeys.size() && previous.groupKeys[g] == res.groupKeys[g]) {
+            res.groupMeshes[g] = previous.groupMeshes[g];
+        }
+        else {
+            res.groupMeshes[g] = Mesher(groupIn, groupOpts).mesh();
+        }
+    }
+    res.mesh = spliceGroups(in.grid, res.groupMeshes);
+    return res;
+}
+
+}
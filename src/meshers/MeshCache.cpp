@@ -0,0 +1,212 @@
+#include "MeshCache.h"
+
+#include "utils/BinaryMeshIO.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace meshlib::meshers {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const std::string CACHE_VERSION = "tessellator-cache-1";
+const std::string CACHE_EXTENSION = ".mesh";
+
+std::uint64_t rotateLeft(std::uint64_t v, int bits)
+{
+    return (v << bits) | (v >> (64 - bits));
+}
+
+}
+
+CacheKey::CacheKey(const std::string& mesherName) :
+    state_{ 0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL }
+{
+    add(CACHE_VERSION);
+    add(mesherName);
+}
+
+CacheKey& CacheKey::add(const std::string& str)
+{
+    add(std::uint64_t(str.size()));
+    addBytes_(str.data(), str.size());
+    return *this;
+}
+
+CacheKey& CacheKey::add(const std::set<GroupId>& ids)
+{
+    add(std::uint64_t(ids.size()));
+    for (auto const& id : ids) {
+        add(std::uint64_t(id));
+    }
+    return *this;
+}
+
+CacheKey& CacheKey::add(const Grid& grid)
+{
+    for (auto const& dir : grid) {
+        add(std::uint64_t(dir.size()));
+        addBytes_(dir.data(), dir.size() * sizeof(CoordinateDir));
+    }
+    return *this;
+}
+
+CacheKey& CacheKey::add(const Mesh& m)
+{
+    add(m.grid);
+    add(std::uint64_t(m.coordinates.size()));
+    for (auto const& c : m.coordinates) {
+        for (std::size_t d = 0; d < 3; d++) {
+            add(c(d));
+        }
+    }
+    add(std::uint64_t(m.groups.size()));
+    for (auto const& g : m.groups) {
+        add(std::uint64_t(g.elements.size()));
+        for (auto const& e : g.elements) {
+            add(e.type);
+            add(std::uint64_t(e.vertices.size()));
+            for (auto const& vId : e.vertices) {
+                add(std::uint64_t(vId));
+            }
+        }
+    }
+    return *this;
+}
+
+std::string CacheKey::toString() const
+{
+    // Finalization mixes the length so that trailing zeros change the key.
+    std::uint64_t h0 = state_[0] ^ length_;
+    std::uint64_t h1 = state_[1] + length_;
+    for (int i = 0; i < 2; i++) {
+        h0 = (h0 ^ rotateLeft(h1, 29)) * 0xFF51AFD7ED558CCDULL;
+        h1 = (h1 ^ rotateLeft(h0, 33)) * 0xC4CEB9FE1A85EC53ULL;
+    }
+
+    std::ostringstream res;
+    res << std::hex << std::setfill('0') << std::setw(16) << h0 << std::setw(16) << h1;
+    return res.str();
+}
+
+void CacheKey::addBytes_(const void* data, std::size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        addWord_(word);
+    }
+    if (i < size) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes + i, size - i);
+        addWord_(word);
+    }
+    length_ += size;
+}
+
+void CacheKey::addWord_(std::uint64_t word)
+{
+    state_[0] = rotateLeft((state_[0] ^ word) * 0x9E3779B97F4A7C15ULL, 31);
+    state_[1] = rotateLeft((state_[1] + word) * 0xC2B2AE3D27D4EB4FULL, 27) ^ state_[0];
+}
+
+MeshCache::MeshCache(const CacheOptions& opts) :
+    opts_(opts)
+{
+    fs::create_directories(opts_.directory);
+}
+
+std::optional<Mesh> MeshCache::load(const CacheKey& key) const
+{
+    const fs::path filename = getFilename_(key);
+    std::error_code ec;
+    if (!fs::exists(filename, ec)) {
+        return std::nullopt;
+    }
+
+    Mesh res;
+    try {
+        res = utils::binaryMeshIO::readMesh(filename);
+    }
+    catch (const std::exception&) {
+        fs::remove(filename, ec);
+        return std::nullopt;
+    }
+    fs::last_write_time(filename, fs::file_time_type::clock::now(), ec);
+    return res;
+}
+
+void MeshCache::store(const CacheKey& key, const Mesh& m) const
+{
+    const fs::path filename = getFilename_(key);
+
+    std::random_device rd;
+    fs::path tmpFilename = filename;
+    tmpFilename += ".tmp" + std::to_string(rd());
+
+    try {
+        utils::binaryMeshIO::writeMesh(tmpFilename, m);
+        fs::rename(tmpFilename, filename);
+    }
+    catch (...) {
+        std::error_code ec;
+        fs::remove(tmpFilename, ec);
+        throw;
+    }
+
+    evict_(filename);
+}
+
+fs::path MeshCache::getFilename_(const CacheKey& key) const
+{
+    return opts_.directory / (key.toString() + CACHE_EXTENSION);
+}
+
+void MeshCache::evict_(const fs::path& keep) const
+{
+    struct Entry {
+        fs::path path;
+        fs::file_time_type lastUse;
+        std::uintmax_t size;
+    };
+
+    std::vector<Entry> entries;
+    std::uintmax_t totalSize = 0;
+    std::error_code ec;
+    for (auto const& f : fs::directory_iterator(opts_.directory, ec)) {
+        if (!f.is_regular_file(ec) || f.path().extension() != CACHE_EXTENSION) {
+            continue;
+        }
+        std::error_code timeError, sizeError;
+        Entry entry{ f.path(), f.last_write_time(timeError), f.file_size(sizeError) };
+        if (timeError || sizeError) {
+            // Removed meanwhile by another process.
+            continue;
+        }
+        totalSize += entry.size;
+        entries.push_back(std::move(entry));
+    }
+
+    std::sort(entries.begin(), entries.end(),
+        [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+    for (auto const& entry : entries) {
+        if (totalSize <= opts_.maxSizeInBytes) {
+            break;
+        }
+        if (entry.path == keep) {
+            continue;
+        }
+        fs::remove(entry.path, ec);
+        totalSize -= entry.size;
+    }
+}
+
+}
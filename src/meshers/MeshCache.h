@@ -0,0 +1,71 @@
+#pragma once
+
+#include "types/Mesh.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+namespace meshlib::meshers {
+
+struct CacheOptions {
+    // Directory where meshing results are stored. The cache is disabled when empty.
+    std::filesystem::path directory;
+    // Least recently used results are removed when the cache grows beyond this size.
+    std::uintmax_t maxSizeInBytes = std::uintmax_t(1) << 30;
+
+    bool isEnabled() const { return !directory.empty(); }
+};
+
+// Hash of everything which determines the result of a mesher: its name, the
+// input mesh and grid and the options which affect the output. It is not a
+// cryptographic hash, but 128 bits make accidental collisions negligible.
+class CacheKey {
+public:
+    explicit CacheKey(const std::string& mesherName);
+
+    template <class T>
+    CacheKey& add(const T& v)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+        addBytes_(&v, sizeof(T));
+        return *this;
+    }
+    CacheKey& add(const std::string&);
+    CacheKey& add(const std::set<GroupId>&);
+    CacheKey& add(const Grid&);
+    CacheKey& add(const Mesh&);
+
+    std::string toString() const;
+
+private:
+    std::array<std::uint64_t, 2> state_;
+    std::uint64_t length_ = 0;
+
+    void addBytes_(const void* data, std::size_t size);
+    void addWord_(std::uint64_t);
+};
+
+// Meshing results stored in a directory, one binary mesh file per key. Loading
+// a result marks it as recently used. Files are written to a temporary name and
+// renamed, so several processes can share a directory.
+class MeshCache {
+public:
+    explicit MeshCache(const CacheOptions&);
+
+    // Returns nothing if the key is not in the cache. Unreadable entries are removed.
+    std::optional<Mesh> load(const CacheKey&) const;
+    // Stores the mesh and evicts least recently used entries if needed.
+    void store(const CacheKey&, const Mesh&) const;
+
+private:
+    CacheOptions opts_;
+
+    std::filesystem::path getFilename_(const CacheKey&) const;
+    void evict_(const std::filesystem::path& keep) const;
+};
+
+}
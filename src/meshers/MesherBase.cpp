@@ -71,6 +71,41 @@ MesherBase::MesherBase(const Mesh& inputMesh) : originalGrid_{inputMesh.grid}
     logGridSize(inputMesh.grid);
 }
 
+bool MesherBase::loadFromCache(const CacheOptions& opts, const CacheKey& key)
+{
+    if (!opts.isEnabled()) {
+        return false;
+    }
+    try {
+        cache_.emplace(opts);
+    }
+    catch (const std::exception& e) {
+        log(std::string("Cache is not available: ") + e.what(), 1);
+        return false;
+    }
+    cacheKey_ = key;
+    cachedMesh_ = cache_->load(key);
+    if (cachedMesh_) {
+        log("Mesh loaded from cache entry " + key.toString() + ".", 1);
+    }
+    pendingStore_ = !cachedMesh_.has_value();
+    return cachedMesh_.has_value();
+}
+
+void MesherBase::storeInCache(const Mesh& m) const
+{
+    if (!cache_ || !pendingStore_) {
+        return;
+    }
+    pendingStore_ = false;
+    try {
+        cache_->store(*cacheKey_, m);
+    }
+    catch (const std::exception& e) {
+        log(std::string("Mesh could not be stored in cache: ") + e.what(), 1);
+    }
+}
+
 Grid MesherBase::buildNonSlicingGrid(const Grid& primal, const Grid& enlarged)
 {
     assert(primal.size() >= 2);
@@ -1,16 +1,31 @@
 #pragma once
 
 #include "types/Mesh.h"
+#include "MeshCache.h"
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace meshlib {
 namespace meshers {
 
 class MesherBase {
 public:
+    using StageTimings = std::vector<std::pair<std::string, double>>;
+
     MesherBase(const Mesh& in);
     virtual ~MesherBase() = default;
     virtual Mesh mesh() const = 0;
 
+    // Seconds spent in each stage while building the mesh. Empty when the
+    // mesh was loaded from the cache.
+    const StageTimings& getStageTimings() const { return stageTimings_; }
+
+    static Grid buildSlicingGrid(const Grid& primal, const Grid& enlarged);
+
 protected:
     virtual void process(Mesh&) const = 0;
 
@@ -21,14 +36,36 @@ protected:
     static void logNumberOfNodes(std::size_t nNodes);
     static void logGridSize(const Grid& g);
 
+    // Runs a stage and records the time spent in it.
+    template <class F>
+    void timeStage(const std::string& stage, F&& f) const
+    {
+        const auto start{ std::chrono::steady_clock::now() };
+        f();
+        const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+        stageTimings_.emplace_back(stage, elapsed.count());
+    }
+
     static Grid buildNonSlicingGrid(const Grid& primal, const Grid& enlarged);
-    static Grid buildSlicingGrid(const Grid& primal, const Grid& enlarged);
 
     static Mesh buildVolumeMesh(const Mesh& inputMesh, const std::set<GroupId>& volumeGroups);
     static Mesh buildSurfaceMesh(const Mesh& inputMesh, const std::set<GroupId>& volumeGroups);
 
+    // Looks up the result in the cache, if enabled, keeping it in cachedMesh_.
+    bool loadFromCache(const CacheOptions&, const CacheKey&);
+    // Stores the result under the key given to loadFromCache, only once and only
+    // if it was not found there. Failures are logged and do not stop meshing.
+    void storeInCache(const Mesh&) const;
+
     Grid originalGrid_;
     Grid enlargedGrid_;
+    std::optional<Mesh> cachedMesh_;
+
+private:
+    mutable StageTimings stageTimings_;
+    std::optional<MeshCache> cache_;
+    std::optional<CacheKey> cacheKey_;
+    mutable bool pendingStore_ = false;
 };
 
 }
@@ -0,0 +1,115 @@
+#include "MultiMesher.h"
+
+#include "MesherBase.h"
+#include "StructuredMesher.h"
+#include "OffgridMesher.h"
+#include "ConformalMesher.h"
+#include "core/Slicer.h"
+#include "core/Collapser.h"
+
+#include "utils/MeshTools.h"
+
+#include <algorithm>
+
+namespace meshlib::meshers {
+
+using namespace utils;
+using namespace meshTools;
+using namespace core;
+
+namespace {
+
+void addPrefix(CheckpointOptions& checkpoints, const std::string& pipeline, const std::string& lastStage, const Mesh& mesh)
+{
+    checkpoints.prefixes[pipeline] = StagePrefix{ lastStage, mesh };
+}
+
+Mesh reorderedCopy(const Mesh& mesh)
+{
+    Mesh res = mesh;
+    reorderSpatially(res);
+    return res;
+}
+
+}
+
+MultiMesherResult meshAll(const Mesh& in, const MultiMesherOptions& opts)
+{
+    const ScopedExecution execution(opts.execution);
+
+    // The surface mesh of the structured mesher, which is the same as the one
+    // of the off-grid mesher without volume groups and as the input of the
+    // conformal one without tetrahedra.
+    Mesh sliced = buildMeshFilteringElements(in, isNotTetrahedron);
+    const bool offgridShares = opts.offgrid && opts.offgrid->volumeGroups.empty();
+    const bool conformalShares = opts.conformal && sliced.countElems() == in.countElems();
+    const int sharing = int(opts.structured) + int(offgridShares) + int(conformalShares);
+
+    std::optional<OffgridMesherOptions> offgridOpts = opts.offgrid;
+    std::optional<ConformalMesherOptions> conformalOpts = opts.conformal;
+    CheckpointOptions structuredCheckpoints;
+
+    if (sharing > 1 && sliced.countElems() != 0) {
+        ValidationLevel validation = ValidationLevel::None;
+        if (opts.structured) {
+            validation = std::max(validation, opts.validation);
+        }
+        if (offgridShares) {
+            validation = std::max(validation, offgridOpts->validation);
+        }
+        if (conformalShares) {
+            validation = std::max(validation, conformalOpts->validation);
+        }
+
+        sliced.grid = MesherBase::buildSlicingGrid(in.grid, getEnlargedGridIncludingAllElements(in));
+        SlicerOptions slicerOpts;
+        slicerOpts.validation = validation;
+        sliced = Slicer{ sliced, slicerOpts }.getMesh();
+
+        std::optional<Mesh> collapsed;
+        if (opts.structured) {
+            collapsed = Collapser(sliced, opts.decimalPlacesInCollapser, validation).getMesh();
+            addPrefix(structuredCheckpoints, "structured", "collapsing", *collapsed);
+        }
+
+        if (offgridShares) {
+            auto& checkpoints = offgridOpts->checkpoints;
+            if (offgridOpts->reorderSpatially) {
+                addPrefix(checkpoints, "offgrid.surface", "slicing", reorderedCopy(sliced));
+            }
+            else if (collapsed && offgridOpts->decimalPlacesInCollapser == opts.decimalPlacesInCollapser) {
+                addPrefix(checkpoints, "offgrid.surface", "collapsing", *collapsed);
+            }
+            else {
+                addPrefix(checkpoints, "offgrid.surface", "slicing", sliced);
+            }
+        }
+
+        if (conformalShares) {
+            addPrefix(
+                conformalOpts->checkpoints, "conformal", "slicing",
+                conformalOpts->reorderSpatially ? reorderedCopy(sliced) : sliced);
+        }
+    }
+
+    MultiMesherResult res;
+    TaskGroup branches;
+    if (opts.structured) {
+        branches.run([&]() {
+            res.structured = StructuredMesher(
+                in, opts.decimalPlacesInCollapser, opts.validation,
+                CacheOptions(), structuredCheckpoints).mesh();
+        });
+    }
+    if (offgridOpts) {
+        branches.run([&]() { res.offgrid = OffgridMesher(in, *offgridOpts).mesh(); });
+    }
+    if (conformalOpts) {
+        branches.run([&]() { res.conformal = ConformalMesher(in, *conformalOpts).mesh(); });
+    }
+    branches.wait();
+
+    return res;
+}
+
+}
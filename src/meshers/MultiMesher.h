@@ -0,0 +1,39 @@
+#pragma once
+
+#include "types/Mesh.h"
+#include "OffgridMesherOptions.h"
+#include "ConformalMesherOptions.h"
+#include "utils/Parallel.h"
+#include "utils/ValidationLevel.h"
+
+#include <optional>
+
+namespace meshlib::meshers {
+
+struct MultiMesherOptions {
+    // Options of the structured mesher, which is run when enabled.
+    bool structured = true;
+    int decimalPlacesInCollapser = 4;
+    utils::ValidationLevel validation = utils::ValidationLevel::Full;
+    // The off-grid and conformal meshers are run when their options are given.
+    std::optional<OffgridMesherOptions> offgrid;
+    std::optional<ConformalMesherOptions> conformal;
+    // Backend and number of threads used while meshing.
+    utils::ExecutionOptions execution;
+};
+
+struct MultiMesherResult {
+    std::optional<Mesh> structured;
+    std::optional<Mesh> offgrid;
+    std::optional<Mesh> conformal;
+};
+
+// Runs several meshers on the same input. The slicing of the surface elements,
+// and their collapsing when the options allow it, is done once and shared by
+// the meshers which start with it; the rest of each pipeline runs concurrently.
+// Results are the same as running each mesher on its own.
+// The off-grid mesher only shares when it has no volume groups and the conformal
+// one when the input has no tetrahedra, as otherwise their inputs differ.
+MultiMesherResult meshAll(const Mesh& in, const MultiMesherOptions& opts);
+
+}
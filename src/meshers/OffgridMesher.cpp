@@ -8,6 +8,7 @@
 
 #include "utils/RedundancyCleaner.h"
 #include "utils/MeshTools.h"
+#include "utils/Parallel.h"
 
 namespace meshlib::meshers {
 
@@ -15,22 +16,61 @@ using namespace utils;
 using namespace meshTools;
 using namespace core;
 
+CacheKey OffgridMesher::buildCacheKey(const Mesh& in, const OffgridMesherOptions& opts)
+{
+    CacheKey res("offgrid");
+    res.add(in)
+        .add(opts.forceSlicing)
+        .add(opts.smooth)
+        .add(opts.snap)
+        .add(opts.snapperOptions.forbiddenLength)
+        .add(opts.snapperOptions.edgePoints)
+        .add(opts.decimalPlacesInCollapser)
+        .add(opts.reorderSpatially)
+        .add(opts.volumeGroups);
+    return res;
+}
+
 OffgridMesher::OffgridMesher(const Mesh& in, const OffgridMesherOptions& opts) :
     MesherBase::MesherBase(in),
     opts_{ opts }
 {        
+    const ScopedExecution execution(opts_.execution);
+    const bool needsKey = opts_.cache.isEnabled() || opts_.checkpoints.isEnabled();
+    const CacheKey key = needsKey ? buildCacheKey(in, opts_) : CacheKey("offgrid");
+    if (loadFromCache(opts_.cache, key)) {
+        return;
+    }
+
     log("Retrieving groups to be meshed as volumes.");
     volumeMesh_ = buildVolumeMesh(in, opts_.volumeGroups);
-    process(volumeMesh_);
+    process(volumeMesh_, StageCheckpoints(opts_.checkpoints, "offgrid.volume", key, buildStages_()));
         
     log("Retrieving groups to be meshed as surfaces.");
     surfaceMesh_ = buildSurfaceMesh(in, opts_.volumeGroups);  
-    process(surfaceMesh_);
+    process(surfaceMesh_, StageCheckpoints(opts_.checkpoints, "offgrid.surface", key, buildStages_()));
 
     log("Initial hull mesh built succesfully.");
 }
 
+std::vector<std::string> OffgridMesher::buildStages_() const
+{
+    std::vector<std::string> res{ "slicing", "collapsing" };
+    if (opts_.smooth || opts_.snap) {
+        res.push_back("smoothing");
+    }
+    if (opts_.snap) {
+        res.push_back("snapping");
+    }
+    return res;
+}
+
 void OffgridMesher::process(Mesh& mesh) const
+{
+    process(mesh, StageCheckpoints(CheckpointOptions(), "offgrid", CacheKey("offgrid"), buildStages_()));
+}
+
+void OffgridMesher::process(Mesh& mesh, const StageCheckpoints& checkpoints) const
 {
     const auto slicingGrid{ buildSlicingGrid(originalGrid_, enlargedGrid_) };
     
@@ -41,29 +81,49 @@ void OffgridMesher::process(Mesh& mesh) const
     
     log("Slicing.", 1);
     mesh.grid = slicingGrid;
-    mesh = Slicer{ mesh }.getMesh();
-        
+    checkpoints.run("slicing", mesh, [&](Mesh& m) {
+        SlicerOptions slicerOpts;
+        slicerOpts.validation = opts_.validation;
+        m = Slicer{ m, slicerOpts }.getMesh();
+        if (opts_.reorderSpatially) {
+            reorderSpatially(m);
+        }
+    });
     logNumberOfTriangles(countMeshElementsIf(mesh, isTriangle));
 
     log("Collapsing.", 1);
-    mesh = Collapser(mesh, opts_.decimalPlacesInCollapser).getMesh();
+    checkpoints.run("collapsing", mesh, [&](Mesh& m) {
+        m = Collapser(m, opts_.decimalPlacesInCollapser, opts_.validation).getMesh();
+    });
     logNumberOfTriangles(countMeshElementsIf(mesh, isTriangle));
         
     if (opts_.smooth || opts_.snap) {
         log("Smoothing.", 1);
-        mesh = Smoother(mesh).getMesh();
+        checkpoints.run("smoothing", mesh, [&](Mesh& m) {
+            SmootherOptions smootherOpts;
+            smootherOpts.validation = opts_.validation;
+            m = Smoother(m, smootherOpts).getMesh();
+        });
         logNumberOfTriangles(countMeshElementsIf(mesh, isTriangle));
     }
 
     if (opts_.snap) {
         log("Snapping.", 1);
-        mesh = Snapper(mesh, opts_.snapperOptions).getMesh();
+        checkpoints.run("snapping", mesh, [&](Mesh& m) {
+            SnapperOptions snapperOpts = opts_.snapperOptions;
+            snapperOpts.validation = opts_.validation;
+            m = Snapper(m, snapperOpts).getMesh();
+        });
         logNumberOfTriangles(countMeshElementsIf(mesh, isTriangle));
     }
 }
 
 Mesh OffgridMesher::mesh() const 
 {
+    if (cachedMesh_) {
+        return *cachedMesh_;
+    }
+
     log("Building primal mesh.");
     Mesh res{ volumeMesh_ };
     mergeMesh(res, surfaceMesh_);
@@ -73,6 +133,7 @@ Mesh OffgridMesher::mesh() const
     RedundancyCleaner::cleanCoords(res);
 
     log("Primal mesh built succesfully.", 1);
+    storeInCache(res);
     return res;
 }
 
@@ -3,6 +3,7 @@
 #include "types/Mesh.h"
 #include "MesherBase.h"
 #include "OffgridMesherOptions.h"
+#include "StageCheckpoints.h"
 
 namespace meshlib::meshers {
 
@@ -13,6 +14,9 @@ public:
     virtual ~OffgridMesher() = default;
     Mesh mesh() const;
 
+    // Key of the result for an input and options, as used by the cache.
+    static CacheKey buildCacheKey(const Mesh& in, const OffgridMesherOptions& opts);
+
 private:
     OffgridMesherOptions opts_;
 
@@ -20,6 +24,8 @@ private:
     Mesh surfaceMesh_;
 
     void process(Mesh&) const;
+    void process(Mesh&, const StageCheckpoints&) const;
+    std::vector<std::string> buildStages_() const;
 
 };
 
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "core/SnapperOptions.h"
+#include "MeshCache.h"
+#include "StageCheckpoints.h"
 #include "types/Mesh.h"
+#include "utils/Parallel.h"
 
 namespace meshlib::meshers {
 
@@ -12,7 +15,18 @@ class OffgridMesherOptions {
         bool snap = true;
         core::SnapperOptions snapperOptions;
         int decimalPlacesInCollapser = 4;
+        // Sorts coordinates and elements by cell after slicing to improve memory locality.
+        bool reorderSpatially = false;
         std::set<GroupId> volumeGroups{};
+        // Overrides the validation level of all stages.
+        utils::ValidationLevel validation = utils::ValidationLevel::Full;
+        // Backend and number of threads used while meshing.
+        utils::ExecutionOptions execution;
+        // Results are reused when the input and the options above are the same.
+        // Validation and execution options do not change results and are ignored.
+        CacheOptions cache;
+        // Snapshots written after each stage and stage to resume from.
+        CheckpointOptions checkpoints;
     
     };
 }
\ No newline at end of file
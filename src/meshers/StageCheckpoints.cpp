@@ -0,0 +1,128 @@
+#include "StageCheckpoints.h"
+
+#include "utils/BinaryMeshIO.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+namespace meshlib::meshers {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char MAGIC[8] = { 'T', 'E', 'S', 'S', 'C', 'K', 'P', 'T' };
+const std::uint32_t VERSION = 1;
+
+void writeString(std::ostream& os, const std::string& str)
+{
+    const std::uint64_t size = str.size();
+    os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    os.write(str.data(), str.size());
+}
+
+std::string readString(std::istream& is)
+{
+    std::uint64_t size = 0;
+    is.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!is || size > 1024) {
+        throw std::runtime_error("Invalid checkpoint header.");
+    }
+    std::string res(size, '\0');
+    is.read(res.data(), size);
+    if (!is) {
+        throw std::runtime_error("Invalid checkpoint header.");
+    }
+    return res;
+}
+
+}
+
+StageCheckpoints::StageCheckpoints(
+    const CheckpointOptions& opts,
+    const std::string& pipelineName,
+    const CacheKey& key,
+    const std::vector<std::string>& stages) :
+    opts_(opts),
+    pipelineName_(pipelineName),
+    key_(key.toString()),
+    stages_(stages)
+{
+    auto prefix = opts_.prefixes.find(pipelineName_);
+    if (prefix != opts_.prefixes.end()) {
+        prefix_ = &prefix->second;
+        resumeIndex_ = findStage_(prefix_->lastStage) + 1;
+    }
+    else if (!opts_.resumeFrom.empty()) {
+        resumeIndex_ = findStage_(opts_.resumeFrom);
+    }
+    if (resumeIndex_ > 0 && !prefix_ && opts_.directory.empty()) {
+        throw std::runtime_error("Resuming from a stage needs a checkpoint directory.");
+    }
+    if (!opts_.directory.empty()) {
+        fs::create_directories(opts_.directory);
+    }
+}
+
+fs::path StageCheckpoints::getSnapshotFilename(const std::string& stage) const
+{
+    return opts_.directory / (pipelineName_ + "." + stage + ".checkpoint");
+}
+
+std::size_t StageCheckpoints::findStage_(const std::string& stage) const
+{
+    auto it = std::find(stages_.begin(), stages_.end(), stage);
+    if (it == stages_.end()) {
+        throw std::runtime_error("Unknown stage in " + pipelineName_ + ": " + stage);
+    }
+    return std::size_t(it - stages_.begin());
+}
+
+Mesh StageCheckpoints::readSnapshot_(const std::string& stage) const
+{
+    const fs::path filename = getSnapshotFilename(stage);
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs) {
+        throw std::runtime_error("Checkpoint could not be opened: " + filename.string());
+    }
+
+    char magic[sizeof(MAGIC)];
+    std::uint32_t version = 0;
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!ifs || !std::equal(magic, magic + sizeof(magic), MAGIC) || version != VERSION) {
+        throw std::runtime_error("File is not a supported checkpoint: " + filename.string());
+    }
+    if (readString(ifs) != stage) {
+        throw std::runtime_error("Checkpoint belongs to another stage: " + filename.string());
+    }
+    if (readString(ifs) != key_) {
+        throw std::runtime_error(
+            "Checkpoint was written with a different input or options: " + filename.string());
+    }
+    return utils::binaryMeshIO::readMesh(ifs);
+}
+
+void StageCheckpoints::writeSnapshot_(const std::string& stage, const Mesh& mesh) const
+{
+    const fs::path filename = getSnapshotFilename(stage);
+    fs::path tmpFilename = filename;
+    tmpFilename += ".tmp" + std::to_string(std::random_device()());
+    {
+        std::ofstream ofs(tmpFilename, std::ios::binary);
+        if (!ofs) {
+            throw std::runtime_error("File could not be opened: " + tmpFilename.string());
+        }
+        ofs.write(MAGIC, sizeof(MAGIC));
+        ofs.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+        writeString(ofs, stage);
+        writeString(ofs, key_);
+        utils::binaryMeshIO::writeMesh(ofs, mesh);
+    }
+    fs::rename(tmpFilename, filename);
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "types/Mesh.h"
+#include "MeshCache.h"
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace meshlib::meshers {
+
+// Mesh resulting from the first stages of a pipeline, computed elsewhere.
+struct StagePrefix {
+    // Last stage included in the mesh.
+    std::string lastStage;
+    Mesh mesh;
+};
+
+struct CheckpointOptions {
+    // Directory where a snapshot of the mesh is written after each stage.
+    // No snapshots are written when empty.
+    std::filesystem::path directory;
+    // First stage to run. The stages before it are skipped and the mesh is
+    // read from the snapshot of the last of them. Runs all stages when empty.
+    std::string resumeFrom;
+    // Prefixes by pipeline name. A pipeline with a prefix skips its stages up
+    // to the last one of the prefix and continues from its mesh.
+    std::map<std::string, StagePrefix> prefixes;
+
+    bool isEnabled() const { return !directory.empty() || !resumeFrom.empty(); }
+};
+
+// Stages of a mesher pipeline with their snapshots. Snapshots store the stage
+// name and the key of the mesher inputs and options, so that a run can only be
+// resumed from snapshots written with the same ones.
+class StageCheckpoints {
+public:
+    StageCheckpoints(
+        const CheckpointOptions&,
+        const std::string& pipelineName,
+        const CacheKey& key,
+        const std::vector<std::string>& stages);
+
+    // Runs the stage on the mesh unless it comes before the one to resume from.
+    template <class F>
+    void run(const std::string& stage, Mesh& mesh, F&& f) const
+    {
+        const std::size_t s = findStage_(stage);
+        if (s < resumeIndex_) {
+            if (s + 1 == resumeIndex_) {
+                mesh = prefix_ ? prefix_->mesh : readSnapshot_(stage);
+            }
+            return;
+        }
+        f(mesh);
+        if (!opts_.directory.empty()) {
+            writeSnapshot_(stage, mesh);
+        }
+    }
+
+    std::filesystem::path getSnapshotFilename(const std::string& stage) const;
+
+private:
+    CheckpointOptions opts_;
+    std::string pipelineName_;
+    std::string key_;
+    std::vector<std::string> stages_;
+    std::size_t resumeIndex_ = 0;
+    const StagePrefix* prefix_ = nullptr;
+
+    std::size_t findStage_(const std::string& stage) const;
+    Mesh readSnapshot_(const std::string& stage) const;
+    void writeSnapshot_(const std::string& stage, const Mesh&) const;
+};
+
+}
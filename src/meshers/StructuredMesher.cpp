@@ -17,15 +17,36 @@ using namespace utils;
 using namespace core;
 using namespace meshTools;
 
-StructuredMesher::StructuredMesher(const Mesh& inputMesh, int decimalPlacesInCollapser) :
+namespace {
+
+const std::vector<std::string> STAGES{ "slicing", "collapsing", "staircasing" };
+
+}
+
+StructuredMesher::StructuredMesher(
+    const Mesh& inputMesh,
+    int decimalPlacesInCollapser,
+    ValidationLevel validation,
+    const CacheOptions& cache,
+    const CheckpointOptions& checkpoints) :
     MesherBase(inputMesh),
-    decimalPlacesInCollapser_(decimalPlacesInCollapser)
+    decimalPlacesInCollapser_(decimalPlacesInCollapser),
+    validation_(validation)
 {
+    CacheKey key("structured");
+    if (cache.isEnabled() || checkpoints.isEnabled()) {
+        key.add(inputMesh).add(decimalPlacesInCollapser_);
+    }
+    if (loadFromCache(cache, key)) {
+        return;
+    }
+
     log("Preparing surfaces.");
     surfaceMesh_ = buildMeshFilteringElements(inputMesh, isNotTetrahedron);
 
     log("Processing surface mesh.");
-    process(surfaceMesh_);
+    process(surfaceMesh_, StageCheckpoints(checkpoints, "structured", key, STAGES));
+    storeInCache(surfaceMesh_);
     
     log("Surface mesh built succesfully.", 1);
 }
@@ -38,6 +59,11 @@ Mesh StructuredMesher::buildSurfaceMesh(const Mesh& inputMesh, const Mesh & volu
 }
 
 void StructuredMesher::process(Mesh& mesh) const
+{
+    process(mesh, StageCheckpoints(CheckpointOptions(), "structured", CacheKey("structured"), STAGES));
+}
+
+void StructuredMesher::process(Mesh& mesh, const StageCheckpoints& checkpoints) const
 {
     
     const auto slicingGrid{ buildSlicingGrid(originalGrid_, enlargedGrid_) };
@@ -49,32 +75,52 @@ void StructuredMesher::process(Mesh& mesh) const
 
     log("Slicing.", 1);
     mesh.grid = slicingGrid;
-    mesh = Slicer{ mesh }.getMesh();
+    timeStage("slicing", [&]() {
+        checkpoints.run("slicing", mesh, [&](Mesh& m) {
+            SlicerOptions slicerOpts;
+            slicerOpts.validation = validation_;
+            m = Slicer{ m, slicerOpts }.getMesh();
+        });
+    });
     
     logNumberOfTriangles(countMeshElementsIf(mesh, isTriangle));
 
     log("Collapsing.", 1);
-    mesh = Collapser(mesh, decimalPlacesInCollapser_).getMesh();
+    timeStage("collapsing", [&]() {
+        checkpoints.run("collapsing", mesh, [&](Mesh& m) {
+            m = Collapser(m, decimalPlacesInCollapser_, validation_).getMesh();
+        });
+    });
 
     logNumberOfTriangles(countMeshElementsIf(mesh, isTriangle));
     
     log("Staircasing.", 1);
-    mesh = Staircaser(mesh).getMesh();
+    timeStage("staircasing", [&]() {
+        checkpoints.run("staircasing", mesh, [&](Mesh& m) {
+            m = Staircaser(m).getMesh();
+        });
+    });
 
     logNumberOfQuads(countMeshElementsIf(mesh, isQuad));
     logNumberOfLines(countMeshElementsIf(mesh, isLine));
 
     log("Removing repeated and overlapping elements.", 1);   
-    RedundancyCleaner::removeOverlappedDimensionOneAndLowerElementsAndEquivalentSurfaces(mesh);
+    timeStage("cleaning", [&]() {
+        RedundancyCleaner::removeOverlappedDimensionOneAndLowerElementsAndEquivalentSurfaces(mesh);
+    });
 
     logNumberOfQuads(countMeshElementsIf(mesh, isQuad));
     logNumberOfLines(countMeshElementsIf(mesh, isLine));
     
     log("Recovering original grid size.", 1);
-    reduceGrid(mesh, originalGrid_);
+    timeStage("reducing", [&]() {
+        reduceGrid(mesh, originalGrid_);
+    });
 
     log("Converting relative to absolute coordinates.", 1);
-    utils::meshTools::convertToAbsoluteCoordinates(mesh);
+    timeStage("converting", [&]() {
+        utils::meshTools::convertToAbsoluteCoordinates(mesh);
+    });
     
     logNumberOfQuads(countMeshElementsIf(mesh, isQuad));
     logNumberOfLines(countMeshElementsIf(mesh, isLine));
@@ -84,6 +130,9 @@ void StructuredMesher::process(Mesh& mesh) const
 
 Mesh StructuredMesher::mesh() const
 {
+    if (cachedMesh_) {
+        return *cachedMesh_;
+    }
     return surfaceMesh_;
 }
 
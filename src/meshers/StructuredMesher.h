@@ -2,22 +2,31 @@
 
 #include "types/Mesh.h"
 #include "MesherBase.h"
+#include "StageCheckpoints.h"
+#include "utils/ValidationLevel.h"
 
 namespace meshlib::meshers {
 
 class StructuredMesher : public MesherBase {
 public:
-	StructuredMesher(const Mesh& in, int decimalPlacesInCollapser = 4);
+	StructuredMesher(
+		const Mesh& in,
+		int decimalPlacesInCollapser = 4,
+		utils::ValidationLevel validation = utils::ValidationLevel::Full,
+		const CacheOptions& cache = CacheOptions(),
+		const CheckpointOptions& checkpoints = CheckpointOptions());
 	virtual ~StructuredMesher() = default;
 	Mesh mesh() const;
 
 private:
 	int decimalPlacesInCollapser_;
+	utils::ValidationLevel validation_;
 
 	Mesh surfaceMesh_;
 
 	virtual Mesh buildSurfaceMesh(const Mesh& inputMesh, const Mesh& volumeSurface);
 	void process(Mesh&) const;
+	void process(Mesh&, const StageCheckpoints&) const;
 
 };
 
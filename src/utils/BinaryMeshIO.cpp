@@ -0,0 +1,183 @@
+#include "BinaryMeshIO.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace meshlib::utils::binaryMeshIO {
+
+namespace {
+
+const char MAGIC[8] = { 'T', 'E', 'S', 'S', 'M', 'E', 'S', 'H' };
+const std::uint32_t VERSION = 1;
+
+class Writer {
+public:
+    template <class T>
+    void write(const T& v)
+    {
+        const char* p = reinterpret_cast<const char*>(&v);
+        buffer_.insert(buffer_.end(), p, p + sizeof(T));
+    }
+
+    void writeSize(std::size_t size) { write(std::uint64_t(size)); }
+
+    const std::vector<char>& getBuffer() const { return buffer_; }
+
+private:
+    std::vector<char> buffer_;
+};
+
+class Reader {
+public:
+    Reader(const char* data, std::size_t size) : data_(data), size_(size) {}
+
+    template <class T>
+    T read()
+    {
+        if (size_ - position_ < sizeof(T)) {
+            throw std::runtime_error("Binary mesh file is truncated.");
+        }
+        T res;
+        std::memcpy(&res, data_ + position_, sizeof(T));
+        position_ += sizeof(T);
+        return res;
+    }
+
+    // Sizes are checked against the remaining bytes, so corrupted files
+    // cannot trigger huge allocations.
+    std::size_t readSize(std::size_t bytesPerItem)
+    {
+        const std::uint64_t res = read<std::uint64_t>();
+        if (res > (size_ - position_) / bytesPerItem) {
+            throw std::runtime_error("Binary mesh file is truncated.");
+        }
+        return std::size_t(res);
+    }
+
+    bool atEnd() const { return position_ == size_; }
+
+private:
+    const char* data_;
+    std::size_t size_;
+    std::size_t position_ = 0;
+};
+
+}
+
+void writeMesh(std::ostream& os, const Mesh& m)
+{
+    Writer w;
+    for (auto const& c : MAGIC) {
+        w.write(c);
+    }
+    w.write(VERSION);
+
+    for (auto const& dir : m.grid) {
+        w.writeSize(dir.size());
+        for (auto const& pos : dir) {
+            w.write(pos);
+        }
+    }
+
+    w.writeSize(m.coordinates.size());
+    for (auto const& c : m.coordinates) {
+        for (std::size_t d = 0; d < 3; d++) {
+            w.write(c(d));
+        }
+    }
+
+    w.writeSize(m.groups.size());
+    for (auto const& g : m.groups) {
+        w.writeSize(g.elements.size());
+        for (auto const& e : g.elements) {
+            w.write(std::uint8_t(e.type));
+            w.writeSize(e.vertices.size());
+            for (auto const& vId : e.vertices) {
+                w.write(std::uint64_t(vId));
+            }
+        }
+    }
+
+    os.write(w.getBuffer().data(), w.getBuffer().size());
+    if (!os) {
+        throw std::runtime_error("Binary mesh could not be written.");
+    }
+}
+
+void writeMesh(const std::filesystem::path& fileName, const Mesh& m)
+{
+    std::ofstream ofs(fileName, std::ios::binary);
+    if (!ofs) {
+        throw std::runtime_error("File could not be opened: " + fileName.string());
+    }
+    writeMesh(ofs, m);
+}
+
+Mesh readMesh(std::istream& is)
+{
+    const std::vector<char> data{ std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>() };
+    Reader r(data.data(), data.size());
+
+    for (auto const& c : MAGIC) {
+        if (r.read<char>() != c) {
+            throw std::runtime_error("File is not a binary mesh.");
+        }
+    }
+    if (r.read<std::uint32_t>() != VERSION) {
+        throw std::runtime_error("Unsupported binary mesh version.");
+    }
+
+    Mesh res;
+    for (auto& dir : res.grid) {
+        dir.resize(r.readSize(sizeof(CoordinateDir)));
+        for (auto& pos : dir) {
+            pos = r.read<CoordinateDir>();
+        }
+    }
+
+    res.coordinates.resize(r.readSize(3 * sizeof(double)));
+    for (auto& c : res.coordinates) {
+        for (std::size_t d = 0; d < 3; d++) {
+            c(d) = r.read<double>();
+        }
+    }
+
+    const std::size_t minElementSize = sizeof(std::uint8_t) + sizeof(std::uint64_t);
+    res.groups.resize(r.readSize(sizeof(std::uint64_t)));
+    for (auto& g : res.groups) {
+        g.elements.resize(r.readSize(minElementSize));
+        for (auto& e : g.elements) {
+            const std::uint8_t type = r.read<std::uint8_t>();
+            if (type > std::uint8_t(Element::Type::Volume)) {
+                throw std::runtime_error("Invalid element type in binary mesh.");
+            }
+            e.type = Element::Type(type);
+            e.vertices.resize(r.readSize(sizeof(std::uint64_t)));
+            for (auto& vId : e.vertices) {
+                vId = CoordinateId(r.read<std::uint64_t>());
+                if (vId >= res.coordinates.size()) {
+                    throw std::runtime_error("Invalid vertex id in binary mesh.");
+                }
+            }
+        }
+    }
+
+    if (!r.atEnd()) {
+        throw std::runtime_error("Binary mesh file has trailing data.");
+    }
+    return res;
+}
+
+Mesh readMesh(const std::filesystem::path& fileName)
+{
+    std::ifstream ifs(fileName, std::ios::binary);
+    if (!ifs) {
+        throw std::runtime_error("File could not be opened: " + fileName.string());
+    }
+    return readMesh(ifs);
+}
+
+}
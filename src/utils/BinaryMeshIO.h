@@ -0,0 +1,19 @@
+#pragma once
+
+#include "types/Mesh.h"
+
+#include <filesystem>
+#include <iostream>
+
+namespace meshlib::utils::binaryMeshIO {
+
+// Compact binary format holding grid, coordinates and groups of a mesh, meant
+// for files written and read back by the library itself. Values are stored
+// with the byte order of the machine.
+void writeMesh(std::ostream&, const Mesh&);
+void writeMesh(const std::filesystem::path& fileName, const Mesh&);
+
+Mesh readMesh(std::istream&);
+Mesh readMesh(const std::filesystem::path& fileName);
+
+}
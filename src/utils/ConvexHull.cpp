@@ -1,6 +1,8 @@
 #include "ConvexHull.h"
 #include "utils/Geometry.h"
 
+#include <boost/container/small_vector.hpp>
+
 #include <numeric>
 
 namespace meshlib::utils {
@@ -45,16 +47,27 @@ bool collinear(Point a, Point b, Point c)
 	return orientation(a, b, c) == 0; 
 }
 
-void grahamScan(std::vector<Point>& a, bool include_collinear = false) 
+struct IndexedPoint {
+	Point p;
+	CoordinateId id;
+};
+
+// Inputs are usually the few points of a triangle inside a cell, so they fit
+// in the inline storage and no memory is allocated.
+using IndexedPoints = boost::container::small_vector<IndexedPoint, 16>;
+
+void grahamScan(IndexedPoints& a, bool include_collinear = false) 
 {
-	Point p0 = *std::min_element(
+	Point p0 = std::min_element(
 		a.begin(), 
-		a.end(), [](Point a, Point b) {
-			return std::make_pair(a.y, a.x) < std::make_pair(b.y, b.x);
+		a.end(), [](const IndexedPoint& a, const IndexedPoint& b) {
+			return std::make_pair(a.p.y, a.p.x) < std::make_pair(b.p.y, b.p.x);
 		}
-	);
+	)->p;
 
-	std::sort(a.begin(), a.end(), [&p0](const Point& a, const Point& b) {
+	std::sort(a.begin(), a.end(), [&p0](const IndexedPoint& ia, const IndexedPoint& ib) {
+		const Point& a = ia.p;
+		const Point& b = ib.p;
 		int o = orientation(p0, a, b);
 		if (o == 0)
 			return (p0.x - a.x) * (p0.x - a.x) + (p0.y - a.y) * (p0.y - a.y)
@@ -63,44 +76,60 @@ void grahamScan(std::vector<Point>& a, bool include_collinear = false)
 		});
 	if (include_collinear) {
 		int i = (int)a.size() - 1;
-		while (i >= 0 && collinear(p0, a[i], a.back())) i--;
-		reverse(a.begin() + i + 1, a.end());
+		while (i >= 0 && collinear(p0, a[i].p, a.back().p)) i--;
+		std::reverse(a.begin() + i + 1, a.end());
 	}
 
-	std::vector<Point> st;
+	IndexedPoints st;
 	for (int i = 0; i < (int)a.size(); i++) {
-		while (st.size() > 1 && !cw(st[st.size() - 2], st.back(), a[i], include_collinear)) {
+		while (st.size() > 1 && !cw(st[st.size() - 2].p, st.back().p, a[i].p, include_collinear)) {
 			st.pop_back();
 		}
 		st.push_back(a[i]);
 	}
 
-	if (include_collinear == false && st.size() == 2 && st[0] == st[1])
+	if (include_collinear == false && st.size() == 2 && st[0].p == st[1].p)
 		st.pop_back();
 
 	a = st;
 }
 
-std::map<Point, CoordinateId> buildPointsInIndex(
+// Points are projected with the same transformation as Geometry::rotateToXYPlane,
+// sorted and, when several ids project to the same point, only the smallest id is kept.
+IndexedPoints buildPointsInXYPlane(
 	const Coordinates& globalCoords,
 	const IdSet& inIds,
 	const VecD& normalVec)
 {
-	Coordinates cs;
-	cs.reserve(inIds.size());
-	std::vector<CoordinateId> originalIds;
-	originalIds.reserve(inIds.size());
-
+	assert(normalVec.norm() != 0.0);
+	const VecD n{ normalVec / normalVec.norm() };
+	const VecD z({ 0.0, 0.0, 1.0 });
+	const VecD u = n ^ z;
+	const double cTh = n(2);
+	const double sTh = sin(acos(cTh));
+	const double xx = cTh + pow(u(0), 2) * (1 - cTh);
+	const double xy = u(0) * u(1) * (1 - cTh) - u(2) * sTh;
+	const double xz = u(0) * u(2) * (1 - cTh) + u(1) * sTh;
+	const double yx = u(1) * u(0) * (1 - cTh) + u(2) * sTh;
+	const double yy = cTh + pow(u(1), 2) * (1 - cTh);
+	const double yz = u(1) * u(2) * (1 - cTh) - u(0) * sTh;
+
+	IndexedPoints res;
+	res.reserve(inIds.size());
 	for (auto const& id : inIds) {
-		cs.push_back(globalCoords[id]);
-		originalIds.push_back(id);
+		const Coordinate& v = globalCoords[id];
+		// As in rotateToXYPlane, the y component uses the already projected x.
+		const double x = xx * v(0) + xy * v(1) + xz * v(2);
+		const double y = yx * x + yy * v(1) + yz * v(2);
+		res.push_back({ Point{ x, y }, id });
 	}
-	Geometry::rotateToXYPlane(cs.begin(), cs.end(), normalVec);
 
-	std::map<Point, CoordinateId> res;
-	for (std::size_t i = 0; i < cs.size(); i++) {
-		res.emplace(Point{ cs[i](0), cs[i](1) }, originalIds[i]);
-	}
+	std::stable_sort(res.begin(), res.end(),
+		[](const IndexedPoint& a, const IndexedPoint& b) { return a.p < b.p; });
+	res.erase(
+		std::unique(res.begin(), res.end(),
+			[](const IndexedPoint& a, const IndexedPoint& b) { return a.p == b.p; }),
+		res.end());
 	return res;
 }
 
@@ -118,32 +147,16 @@ std::vector<CoordinateId> ConvexHull::get(const IdSet& ids, const VecD& normalVe
 		return std::vector<CoordinateId>(ids.begin(), ids.end());
 	}
 
-	auto pointsIndex{ buildPointsInIndex(*globalCoords_, ids, normalVec) };
-	if (pointsIndex.size() <= 2) {
-		std::vector<CoordinateId> res;
-		for (const auto& point : pointsIndex) {
-			res.push_back(point.second);
-		}
-		return res;
-	}
-		
-
-	std::vector<Point> points(pointsIndex.size());
-	auto it{ pointsIndex.begin() };
-	for (std::size_t i{ 0 }; i < points.size(); ++i) {
-		points[i] = it->first;
-		++it;
+	auto points{ buildPointsInXYPlane(*globalCoords_, ids, normalVec) };
+	if (points.size() > 2) {
+		grahamScan(points, true);
 	}
 
-	grahamScan(points, true);
-
 	std::vector<CoordinateId> res;
 	res.reserve(points.size());
 	for (const auto& point : points) {
-		CoordinateId id{ pointsIndex.find(point)->second };
-		res.push_back(id);
+		res.push_back(point.id);
 	}
-
 	return res;
 }
 
@@ -566,6 +566,8 @@ Elements CoordGraph::getEdgesAsLines() const
 
 struct cycle_recorder
 {
+    struct full {};
+
     template <typename Path, typename graph_t>
     inline void cycle(const Path& p, const graph_t& g)
     { 
@@ -573,17 +575,65 @@ struct cycle_recorder
         for (auto v : p) {
             cycles->back().push_back(g[v].id);
         }
+        if (cycles->size() >= maxCycles) {
+            throw full();
+        }
     }
     std::vector<CoordGraph::Path>* cycles;
+    std::size_t maxCycles;
 };
 
-std::vector<CoordGraph::Path> CoordGraph::findCycles() const
+bool CoordGraph::isUnionOfSimpleCycles() const
+{
+    for (auto v : make_iterator_range(vertices(graph_))) {
+        if (out_degree(v, graph_) != 1 || in_degree(v, graph_) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Each cycle starts at its first vertex and follows the only out edge of each
+// vertex, as tiernan_all_cycles would do. Runs in linear time.
+CoordGraph::Paths CoordGraph::findSimpleCycles(std::size_t maxCycles) const
+{
+    Paths res;
+    std::vector<bool> visited(num_vertices(graph_), false);
+    for (auto v : make_iterator_range(vertices(graph_))) {
+        if (res.size() >= maxCycles) {
+            break;
+        }
+        if (visited[v]) {
+            continue;
+        }
+        res.push_back({});
+        auto u = v;
+        do {
+            visited[u] = true;
+            res.back().push_back(graph_[u].id);
+            u = target(*out_edges(u, graph_).first, graph_);
+        } while (u != v);
+    }
+    return res;
+}
+
+std::vector<CoordGraph::Path> CoordGraph::findCycles(std::size_t maxCycles) const
 {
+    if (isUnionOfSimpleCycles()) {
+        return findSimpleCycles(maxCycles);
+    }
+
     std::vector<Path> res;
-    cycle_recorder vis{&res};
-    tiernan_all_cycles(graph_, vis);
+    if (maxCycles == 0) {
+        return res;
+    }
+    cycle_recorder vis{&res, maxCycles};
+    try {
+        tiernan_all_cycles(graph_, vis);
+    }
+    catch (const cycle_recorder::full&) {}
     return res;
 }
 
 }
-}
\ No newline at end of file
+}
@@ -10,6 +10,7 @@
 #include <boost/function.hpp>
 
 #include <iostream>
+#include <limits>
 
 namespace meshlib {
 namespace utils {
@@ -63,7 +64,10 @@ public:
 
     IdSet getClosestVerticesInSet(const CoordinateId& id, const IdSet& coordSet) const;
 
-    Paths findCycles() const;
+    // Cycles are found by following edges when each vertex has a single
+    // in and out edge. Otherwise all elementary cycles are enumerated, stopping
+    // after finding maxCycles.
+    Paths findCycles(std::size_t maxCycles = std::numeric_limits<std::size_t>::max()) const;
     bool isOrientableAndCyclic(const Path&) const;
 
     Paths findAcyclicPaths() const;
@@ -86,7 +90,8 @@ private:
     VertexMap vertexMap_;
     graph_t graph_;
 
-    std::vector<std::vector<VertexId>> findCycles_() const;
+    bool isUnionOfSimpleCycles() const;
+    Paths findSimpleCycles(std::size_t maxCycles) const;
     IdSet getExtremes() const;
 
     static Paths removeRepeated(const Paths&);
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace meshlib {
+namespace utils {
+
+// Mixes the bits of a hash so that sequential ids spread over the table.
+inline std::size_t mixHash(std::size_t h)
+{
+    std::uint64_t x = h;
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return std::size_t(x);
+}
+
+template <class T, std::size_t N>
+struct ArrayHash {
+    std::size_t operator()(const std::array<T, N>& a) const
+    {
+        std::size_t h = 0;
+        for (const auto& v : a) {
+            h = mixHash(h ^ std::hash<T>{}(v));
+        }
+        return h;
+    }
+};
+
+// Open-addressing hash map with linear probing. Keys and values are stored in
+// flat arrays, so insertions do not allocate per entry. Entries can not be erased.
+template <class Key, class Value, class Hash = std::hash<Key>>
+class FlatHashMap {
+public:
+    explicit FlatHashMap(std::size_t expectedSize = 0)
+    {
+        reserve(expectedSize);
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void reserve(std::size_t n)
+    {
+        std::size_t capacity = 16;
+        while (capacity < 2 * n) {
+            capacity *= 2;
+        }
+        if (capacity > used_.size()) {
+            rehash_(capacity);
+        }
+    }
+
+    // Returns a pointer to the value stored for the key and whether it was inserted.
+    std::pair<Value*, bool> emplace(const Key& key, const Value& value)
+    {
+        if (2 * (size_ + 1) > used_.size()) {
+            rehash_(2 * used_.size());
+        }
+        std::size_t i = findSlot_(key);
+        if (used_[i]) {
+            return { &values_[i], false };
+        }
+        used_[i] = true;
+        keys_[i] = key;
+        values_[i] = value;
+        size_++;
+        return { &values_[i], true };
+    }
+
+    Value& operator[](const Key& key)
+    {
+        return *emplace(key, Value()).first;
+    }
+
+    Value* find(const Key& key)
+    {
+        std::size_t i = findSlot_(key);
+        return used_[i] ? &values_[i] : nullptr;
+    }
+
+    const Value* find(const Key& key) const
+    {
+        std::size_t i = findSlot_(key);
+        return used_[i] ? &values_[i] : nullptr;
+    }
+
+    std::size_t count(const Key& key) const
+    {
+        return used_[findSlot_(key)] ? 1 : 0;
+    }
+
+    template <class F>
+    void forEach(F&& f) const
+    {
+        for (std::size_t i = 0; i < used_.size(); i++) {
+            if (used_[i]) {
+                f(keys_[i], values_[i]);
+            }
+        }
+    }
+
+private:
+    std::vector<Key> keys_;
+    std::vector<Value> values_;
+    std::vector<char> used_;
+    std::size_t size_ = 0;
+
+    std::size_t findSlot_(const Key& key) const
+    {
+        const std::size_t mask = used_.size() - 1;
+        std::size_t i = mixHash(Hash{}(key)) & mask;
+        while (used_[i] && !(keys_[i] == key)) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void rehash_(std::size_t capacity)
+    {
+        std::vector<Key> oldKeys = std::exchange(keys_, std::vector<Key>(capacity));
+        std::vector<Value> oldValues = std::exchange(values_, std::vector<Value>(capacity));
+        std::vector<char> oldUsed = std::exchange(used_, std::vector<char>(capacity, false));
+        size_ = 0;
+        for (std::size_t i = 0; i < oldUsed.size(); i++) {
+            if (oldUsed[i]) {
+                std::size_t j = findSlot_(oldKeys[i]);
+                used_[j] = true;
+                keys_[j] = std::move(oldKeys[i]);
+                values_[j] = std::move(oldValues[i]);
+                size_++;
+            }
+        }
+    }
+};
+
+template <class Key, class Hash = std::hash<Key>>
+class FlatHashSet {
+public:
+    explicit FlatHashSet(std::size_t expectedSize = 0) : map_(expectedSize) {}
+
+    std::size_t size() const { return map_.size(); }
+    bool empty() const { return map_.empty(); }
+    void reserve(std::size_t n) { map_.reserve(n); }
+
+    // Returns true if the key was not already present.
+    bool insert(const Key& key) { return map_.emplace(key, 1).second; }
+    std::size_t count(const Key& key) const { return map_.count(key); }
+
+private:
+    FlatHashMap<Key, char, Hash> map_;
+};
+
+}
+}
@@ -1,8 +1,9 @@
 #include "Geometry.h"
 #include "utils/CoordGraph.h"
-#include "utils/ElemGraph.h"
-
+#include "utils/FlatHashMap.h"
+#include "utils/UnionFind.h"
 
+#include <cmath>
 #include <stdexcept>
 
 namespace meshlib {
@@ -44,6 +45,37 @@ bool Geometry::areAdjacentLines(
     return false;
 }
 
+std::vector<std::pair<std::size_t, std::size_t>> Geometry::buildTrianglesAdjacencies(
+    const ElementsView& tris)
+{
+    using Side = std::array<CoordinateId, 2>;
+    FlatHashMap<Side, std::size_t, ArrayHash<CoordinateId, 2>> lastWithSide(3 * tris.size());
+    std::vector<std::pair<std::size_t, std::size_t>> res;
+    res.reserve(3 * tris.size() / 2);
+    for (std::size_t i = 0; i < tris.size(); i++) {
+        const auto& vs = tris[i]->vertices;
+        for (std::size_t f = 0; f < vs.size(); f++) {
+            Side side{ vs[f], vs[(f + 1) % 3] };
+            if (side[0] > side[1]) {
+                std::swap(side[0], side[1]);
+            }
+            auto inserted = lastWithSide.emplace(side, i);
+            if (inserted.second) {
+                continue;
+            }
+            const std::size_t j = std::exchange(*inserted.first, i);
+            if (areAdjacentWithSameTopologicalOrientation(*tris[j], *tris[i])) {
+                res.emplace_back(j, i);
+            }
+        }
+    }
+    return res;
+}
+
+// Elements are adjacent when they are lines sharing a vertex or triangles
+// sharing a side with the same orientation, as in ElemGraph. Adjacent elements
+// belong to the same set if the angle between them is not above smoothingAngle.
+// Sets are ordered by their first element and keep the order of elements.
 std::vector<ElementsView> Geometry::buildDisjointSmoothSets(
     const ElementsView& elemsIn,
     const Coordinates& coords,
@@ -55,16 +87,62 @@ std::vector<ElementsView> Geometry::buildDisjointSmoothSets(
         std::back_inserter(elems),
         [](const Element* e) { return !e->isNone(); }
     );
+    if (elems.empty()) {
+        return {};
+    }
+
+    const double pi = atan(1) * 4.0;
+    UnionFind sets(elems.size());
+    auto uniteIfSmooth = [&](std::size_t i, std::size_t j, double angle) {
+        if (!(angle * 360.0 / (2.0 * pi) > smoothingAngle)) {
+            sets.unite(i, j);
+        }
+    };
+
+    if (std::all_of(elems.begin(), elems.end(), [](const Element* e) {return e->isLine(); })) {
+        std::vector<std::pair<CoordinateId, std::size_t>> vertexToLines;
+        vertexToLines.reserve(2 * elems.size());
+        for (std::size_t i = 0; i < elems.size(); i++) {
+            for (auto const& vId : elems[i]->vertices) {
+                vertexToLines.emplace_back(vId, i);
+            }
+        }
+        std::sort(vertexToLines.begin(), vertexToLines.end());
+        for (auto begin = vertexToLines.begin(); begin != vertexToLines.end(); ) {
+            auto end = std::find_if(begin, vertexToLines.end(),
+                [&](const auto& p) { return p.first != begin->first; });
+            for (auto it = begin; it != end; ++it) {
+                for (auto itComp = std::next(it); itComp != end; ++itComp) {
+                    const Element& l1 = *elems[it->second];
+                    const Element& l2 = *elems[itComp->second];
+                    VecD t1 = coords[l1.vertices[1]] - coords[l1.vertices[0]];
+                    VecD t2 = coords[l2.vertices[1]] - coords[l2.vertices[0]];
+                    uniteIfSmooth(it->second, itComp->second, t1.angle(t2));
+                }
+            }
+            begin = end;
+        }
+    }
+    else if (std::all_of(elems.begin(), elems.end(), [](const Element* e) {return e->isTriangle(); })) {
+        std::vector<VecD> normals(elems.size());
+        for (std::size_t i = 0; i < elems.size(); i++) {
+            normals[i] = normal(asTriV(*elems[i], coords));
+        }
 
-    ElemGraph elemGraph(elems, coords);
-    std::vector<ElemGraph> smoothGraphs = elemGraph.splitByWeight(smoothingAngle);
-    std::vector<ElementsView> smoothSets;
-    for (const ElemGraph& smoothGraph : smoothGraphs) {
-        ElementsView elemView;
-        for (const auto& smoothIds : smoothGraph.getVertices()) {
-            elemView.push_back(elems.at(smoothIds));
+        for (auto const& adj : buildTrianglesAdjacencies(elems)) {
+            uniteIfSmooth(adj.first, adj.second, normals[adj.first].angle(normals[adj.second]));
         }
-        smoothSets.push_back(elemView);
+    }
+    else {
+        throw std::runtime_error("All elements must be of the same type.");
+    }
+
+    std::vector<std::size_t> labels;
+    std::size_t numberOfSets;
+    std::tie(labels, numberOfSets) = sets.labels();
+    std::vector<ElementsView> smoothSets(numberOfSets);
+    for (std::size_t i = 0; i < elems.size(); i++) {
+        smoothSets[labels[i]].push_back(elems[i]);
     }
     return smoothSets;
 }
@@ -229,6 +307,113 @@ double Geometry::area(const TriV& tri) {
     return ((tri[0] - tri[1]) ^ (tri[1] - tri[2])).norm() / 2.0;
 }
 
+namespace {
+
+// Coordinates of the vertices of a list of triangles. Component d of vertex
+// i of the t-th triangle is in cs[3*i + d][t].
+struct TrianglesSoA {
+    std::array<std::vector<double>, 9> cs;
+    std::vector<std::size_t> elementIds;
+};
+
+TrianglesSoA gatherTriangles(const Elements& elems, const Coordinates& coords)
+{
+    TrianglesSoA res;
+    res.elementIds.reserve(elems.size());
+    for (std::size_t e = 0; e < elems.size(); e++) {
+        if (elems[e].isTriangle()) {
+            res.elementIds.push_back(e);
+        }
+    }
+    for (auto& c : res.cs) {
+        c.resize(res.elementIds.size());
+    }
+    for (std::size_t t = 0; t < res.elementIds.size(); t++) {
+        const auto& vs = elems[res.elementIds[t]].vertices;
+        for (std::size_t i = 0; i < 3; i++) {
+            for (std::size_t d = 0; d < 3; d++) {
+                res.cs[3 * i + d][t] = coords[vs[i]](d);
+            }
+        }
+    }
+    return res;
+}
+
+// Computes u ^ v for u = a - b and v = c - d, with the same operations as
+// the cross product of two VecD.
+void crossOfDifferences(
+    std::size_t n,
+    const double* ax, const double* ay, const double* az,
+    const double* bx, const double* by, const double* bz,
+    const double* cx, const double* cy, const double* cz,
+    const double* dx, const double* dy, const double* dz,
+    double* rx, double* ry, double* rz)
+{
+    for (std::size_t t = 0; t < n; t++) {
+        const double ux = ax[t] - bx[t], uy = ay[t] - by[t], uz = az[t] - bz[t];
+        const double vx = cx[t] - dx[t], vy = cy[t] - dy[t], vz = cz[t] - dz[t];
+        rx[t] = uy * vz - vy * uz;
+        ry[t] = uz * vx - vz * ux;
+        rz[t] = ux * vy - vx * uy;
+    }
+}
+
+}
+
+std::vector<double> Geometry::areas(const Elements& elems, const Coordinates& coords)
+{
+    const TrianglesSoA tris = gatherTriangles(elems, coords);
+    const auto& c = tris.cs;
+    const std::size_t n = tris.elementIds.size();
+
+    std::vector<double> x(n), y(n), z(n);
+    crossOfDifferences(n,
+        c[0].data(), c[1].data(), c[2].data(), c[3].data(), c[4].data(), c[5].data(),
+        c[3].data(), c[4].data(), c[5].data(), c[6].data(), c[7].data(), c[8].data(),
+        x.data(), y.data(), z.data());
+
+    std::vector<double> triAreas(n);
+    for (std::size_t t = 0; t < n; t++) {
+        triAreas[t] = std::sqrt(x[t] * x[t] + y[t] * y[t] + z[t] * z[t]) / 2.0;
+    }
+
+    std::vector<double> res(elems.size(), 0.0);
+    for (std::size_t t = 0; t < n; t++) {
+        res[tris.elementIds[t]] = triAreas[t];
+    }
+    return res;
+}
+
+std::vector<VecD> Geometry::normals(const Elements& elems, const Coordinates& coords)
+{
+    const TrianglesSoA tris = gatherTriangles(elems, coords);
+    const auto& c = tris.cs;
+    const std::size_t n = tris.elementIds.size();
+
+    std::vector<double> x(n), y(n), z(n);
+    crossOfDifferences(n,
+        c[3].data(), c[4].data(), c[5].data(), c[0].data(), c[1].data(), c[2].data(),
+        c[6].data(), c[7].data(), c[8].data(), c[0].data(), c[1].data(), c[2].data(),
+        x.data(), y.data(), z.data());
+
+    std::vector<VecD> res(elems.size(), VecD(0.0));
+    for (std::size_t t = 0; t < n; t++) {
+        res[tris.elementIds[t]] = VecD({ x[t], y[t], z[t] });
+    }
+    return res;
+}
+
+std::vector<bool> Geometry::areDegenerate(
+    const Elements& elems, const Coordinates& coords, double areaTolerance)
+{
+    const std::vector<double> as = areas(elems, coords);
+    std::vector<bool> res(elems.size(), false);
+    for (std::size_t e = 0; e < elems.size(); e++) {
+        res[e] = elems[e].isTriangle() && as[e] < areaTolerance;
+    }
+    return res;
+}
+
 
 }
 }
@@ -24,6 +24,11 @@ public:
         const Coordinates& coords,
         const double smoothingAngle);
 
+    // Pairs of triangles sharing a side with the same topological orientation.
+    // Triangles sharing the same side are paired in order, as in ElemGraph.
+    static std::vector<std::pair<std::size_t, std::size_t>> buildTrianglesAdjacencies(
+        const ElementsView& tris);
+
     static bool areAdjacentWithSameTopologicalOrientation( const Element&, const Element&);
     static bool areAdjacentLines(const Element&, const Element&);
     
@@ -39,6 +44,16 @@ public:
     static VecD getCentroid(const TriV&);
     static double area(const TriV& tri);
     static bool isDegenerate(const TriV& tri, const double& areaTolerance = NORM_TOLERANCE);
+
+    // Batch versions of area, normal and isDegenerate for all triangles in a
+    // list of elements, with results indexed as the elements. Triangle vertices
+    // are gathered as structure of arrays, so the arithmetic is vectorized and
+    // gives the same values as the single triangle versions. Elements which
+    // are not triangles get a null area and normal and are not degenerate.
+    static std::vector<double> areas(const Elements&, const Coordinates&);
+    static std::vector<VecD> normals(const Elements&, const Coordinates&);
+    static std::vector<bool> areDegenerate(
+        const Elements&, const Coordinates&, double areaTolerance = NORM_TOLERANCE);
     static bool areCollinear(const Coordinates&);
     template <std::size_t N>
     static std::array<CoordinateId, N> toArray(
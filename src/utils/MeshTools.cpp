@@ -5,9 +5,18 @@
 #include "GridTools.h"
 #include "ElemGraph.h"
 #include "CoordGraph.h"
-
+#include "FlatHashMap.h"
+#include "Geometry.h"
+#include "UnionFind.h"
+#include "Parallel.h"
+
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
 #include <sstream>
 
+
 namespace meshlib::utils::meshTools {
 
 std::size_t countMeshElementsIf(const Mesh& mesh, std::function<bool(const Element&)> countFilter) {
@@ -55,47 +64,103 @@ Mesh duplicateCoordinatesUsedByDifferentGroups(const Mesh& mesh)
     return res;
 }
 
+namespace {
+
+// Labels elements by connected component, numbering components in order of
+// their first element. Lines are connected when they share a vertex and
+// triangles when they share a side with the same orientation, as in ElemGraph.
+std::pair<std::vector<std::size_t>, std::size_t> labelConnectedElements(const Elements& es)
+{
+    UnionFind components(es.size());
+    if (std::all_of(es.begin(), es.end(), [](const Element& e) { return e.isLine(); })) {
+        FlatHashMap<CoordinateId, ElementId> firstWithVertex(2 * es.size());
+        for (std::size_t i = 0; i < es.size(); i++) {
+            for (auto const& vId : es[i].vertices) {
+                components.unite(*firstWithVertex.emplace(vId, i).first, i);
+            }
+        }
+    }
+    else if (std::all_of(es.begin(), es.end(), [](const Element& e) { return e.isTriangle(); })) {
+        ElementsView tris;
+        tris.reserve(es.size());
+        for (auto const& e : es) {
+            tris.push_back(&e);
+        }
+        for (auto const& adj : Geometry::buildTrianglesAdjacencies(tris)) {
+            components.unite(adj.first, adj.second);
+        }
+    }
+    else {
+        throw std::runtime_error("All elements must be of the same type.");
+    }
+    return components.labels();
+}
+
+}
+
 Mesh duplicateCoordinatesSharedBySingleTrianglesVertex(const Mesh& mesh)
 {
     Mesh res = mesh;
 
     for (auto& g : res.groups) {
-        IdSet sharedBySingleVertex;
-        std::vector<IdSet> idSets;
-        auto disjointElementsGraphs = ElemGraph(g.elements, res.coordinates).split();
-        if (disjointElementsGraphs.size() == 1) {
+        if (g.elements.empty()) {
             continue;
         }
 
-        for (const auto& disjointElementsGraph : disjointElementsGraphs) {
-            auto elementsInGraph = disjointElementsGraph.getAsElements(g.elements);
-            idSets.push_back(CoordGraph(elementsInGraph).getVertices());
+        std::vector<std::size_t> component;
+        std::size_t numberOfComponents;
+        std::tie(component, numberOfComponents) = labelConnectedElements(g.elements);
+        if (numberOfComponents == 1) {
+            continue;
         }
 
-        for (auto i = 0; i < idSets.size(); i++) {
-            for (auto j = i+1; j < idSets.size(); j++) {
-                IdSet shared = intersectWithIdSet(idSets[i], idSets[j]);
-                sharedBySingleVertex.insert(shared.begin(), shared.end());
+        // A vertex is shared when it belongs to elements of different components.
+        FlatHashSet<CoordinateId> sharedBySingleVertex;
+        {
+            FlatHashMap<CoordinateId, std::size_t> vertexComponent(3 * g.elements.size());
+            for (std::size_t eId = 0; eId < g.elements.size(); eId++) {
+                for (auto const& vId : g.elements[eId].vertices) {
+                    auto c = vertexComponent.emplace(vId, component[eId]).first;
+                    if (*c != component[eId]) {
+                        sharedBySingleVertex.insert(vId);
+                    }
+                }
             }
         }
-        
-        for (auto i = 1; i < disjointElementsGraphs.size(); i++) {
-            std::map<CoordinateId, CoordinateId> remapedCoord;
-            for (auto& eId : disjointElementsGraphs[i].getVertices()) {
-                Element& e = g.elements[eId];
+        if (sharedBySingleVertex.empty()) {
+            continue;
+        }
+
+        // Elements are visited by component, each one in ascending order.
+        std::vector<std::size_t> componentBegin(numberOfComponents + 1, 0);
+        for (auto const& c : component) {
+            componentBegin[c + 1]++;
+        }
+        for (std::size_t c = 0; c < numberOfComponents; c++) {
+            componentBegin[c + 1] += componentBegin[c];
+        }
+        std::vector<ElementId> elementsByComponent(g.elements.size());
+        {
+            std::vector<std::size_t> pos(componentBegin.begin(), componentBegin.end() - 1);
+            for (std::size_t eId = 0; eId < g.elements.size(); eId++) {
+                elementsByComponent[pos[component[eId]]++] = eId;
+            }
+        }
+
+        for (std::size_t c = 1; c < numberOfComponents; c++) {
+            FlatHashMap<CoordinateId, CoordinateId> remapedCoord;
+            for (std::size_t i = componentBegin[c]; i < componentBegin[c + 1]; i++) {
+                Element& e = g.elements[elementsByComponent[i]];
                 for (auto& vId : e.vertices) {
                     if (sharedBySingleVertex.count(vId) == 0) {
                         continue;
                     }
-                    if (remapedCoord.count(vId) == 0) {
+                    auto remaped = remapedCoord.emplace(vId, res.coordinates.size());
+                    if (remaped.second) {
                         Coordinate newCoord = res.coordinates[vId];
-                        CoordinateId newVId = res.coordinates.size();
                         res.coordinates.push_back(newCoord);
-                        remapedCoord.emplace(vId, newVId);
-                        vId = newVId;
-                    } else {
-                        vId = remapedCoord[vId];
                     }
+                    vId = *remaped.first;
                 }
             }
         }
@@ -124,36 +189,41 @@ Grid getEnlargedGridIncludingAllElements(const Mesh& m)
 
 std::pair<VecD, VecD> getElementsBoundingBox(const Mesh& m)
 {
-    VecD minBB(std::numeric_limits<double>::max());
-    VecD maxBB(std::numeric_limits<double>::lowest());
-
-    GridTools gT{ m.grid };
-    Coordinates newPos{ m.coordinates };
-    for (auto& pos : newPos) {
-        Coordinate meshedPos{ gT.getPos(gT.getRelative(pos).round(1e6)) };
-        if (GridTools::approx(meshedPos, pos, 1e-6)) {
-            pos = meshedPos;
-        }
-    }
+    typedef std::pair<VecD, VecD> BoundingBox;
+    const BoundingBox empty{
+        VecD(std::numeric_limits<double>::max()),
+        VecD(std::numeric_limits<double>::lowest())
+    };
 
+    std::vector<char> used(m.coordinates.size(), false);
     for (auto const& g : m.groups) {
         for (auto const& e : g.elements) {
             for (auto const& vId : e.vertices) {
-                const Coordinate& coord = newPos[vId];
-                for (std::size_t d = 0; d < 3; d++) {
-
-                    if (coord(d) < minBB(d)) {
-                        minBB(d) = coord(d);
-                    }
-                    if (coord(d) > maxBB(d)) {
-                        maxBB(d) = coord(d);
-                    }
-                }
+                used[vId] = true;
             }
         }
     }
 
-    return std::make_pair(minBB, maxBB);
+    // Positions closer than the tolerance to their value snapped to the grid
+    // are bounded as if they were snapped.
+    GridTools gT{ m.grid };
+    return parallelReduce(std::size_t(0), m.coordinates.size(), empty,
+        [&](std::size_t id) {
+            if (!used[id]) {
+                return empty;
+            }
+            const Coordinate& pos = m.coordinates[id];
+            const Coordinate meshedPos{ gT.getPos(gT.getRelative(pos).round(1e6)) };
+            const Coordinate& c = GridTools::approx(meshedPos, pos, 1e-6) ? meshedPos : pos;
+            return BoundingBox{ c, c };
+        },
+        [](BoundingBox a, const BoundingBox& b) {
+            for (std::size_t d = 0; d < 3; d++) {
+                a.first(d) = std::min(a.first(d), b.first(d));
+                a.second(d) = std::max(a.second(d), b.second(d));
+            }
+            return a;
+        });
 }
 
 void reduceGrid(Mesh& m, const Grid& nG)
@@ -190,33 +260,83 @@ Mesh reduceGrid(const Mesh& m, const Grid& g)
     return r;
 }
 
-void checkNoCellsAreCrossed(const Mesh& m)
+namespace {
+
+// Finds the elements for which a condition holds. With Cheap validation the
+// search stops at the first one found.
+template <class Condition>
+std::vector<ElementId> findElementsIf(
+    const Elements& es, ValidationLevel level, Condition cnd)
+{
+    std::vector<ElementId> res;
+    if (level == ValidationLevel::None) {
+        return res;
+    }
+    if (level == ValidationLevel::Cheap) {
+        std::atomic<std::size_t> first{ es.size() };
+        parallelFor(0, es.size(), [&](std::size_t e) {
+            if (e < first && cnd(es[e])) {
+                std::size_t current = first;
+                while (e < current && !first.compare_exchange_weak(current, e)) {}
+            }
+        });
+        if (first < es.size()) {
+            res.push_back(first);
+        }
+        return res;
+    }
+
+    std::vector<char> found(es.size());
+    parallelFor(0, es.size(), [&](std::size_t e) { found[e] = cnd(es[e]) ? 1 : 0; });
+    for (std::size_t e = 0; e < es.size(); e++) {
+        if (found[e]) {
+            res.push_back(e);
+        }
+    }
+    return res;
+}
+
+// Throws with the elements for which a condition holds in any group.
+template <class Condition>
+void checkNoElementsIf(
+    const Mesh& m, ValidationLevel level, const std::string& invariant, Condition cnd)
 {
     std::stringstream msg;
-    GridTools gT(m.grid);
-    bool crossesGrid = false;
+    bool found = false;
     for (auto const& g : m.groups) {
-        for (auto const& e : g.elements) {
-            if (gT.elementCrossesGrid(e, m.coordinates)) {
-                crossesGrid = true;
-                msg << std::endl;
-                msg << "Group: " << &g - &m.groups.front()
-                    << ", Element: " << &e - &g.elements.front() << std::endl;
-                msg << info(e, m) << std::endl;
-            }
+        for (auto const& eId : findElementsIf(g.elements, level, [&](auto const& e) { return cnd(g, e); })) {
+            found = true;
+            msg << std::endl;
+            msg << "Group: " << &g - &m.groups.front()
+                << ", Element: " << eId << std::endl;
+            msg << info(g.elements[eId], m) << std::endl;
+        }
+        if (found && level == ValidationLevel::Cheap) {
+            break;
         }
     }
-    if (crossesGrid) {
-        msg << std::endl << "Invalid cell invariant: element spans more than one cell.";
+    if (found) {
+        msg << std::endl << invariant;
         throw std::runtime_error(msg.str());
     }
+}
 
 }
 
-void checkNoOverlaps(const Mesh& m)
+void checkNoCellsAreCrossed(const Mesh& m, ValidationLevel level)
+{
+    GridTools gT(m.grid);
+    checkNoElementsIf(m, level, "Invalid cell invariant: element spans more than one cell.",
+        [&](auto const&, auto const& e) { return gT.elementCrossesGrid(e, m.coordinates); });
+}
+
+void checkNoOverlaps(const Mesh& m, ValidationLevel level)
 {
+    if (level != ValidationLevel::Full) {
+        return;
+    }
+
     std::stringstream msg;
-    double angle = 180;
     bool misoriented = false;
     for (const auto& g : m.groups) {
         ElemGraph eG(g.elements, m.coordinates);
@@ -236,38 +356,32 @@ void checkNoOverlaps(const Mesh& m)
 
 }
 
-void checkNoNullAreasExist(const Mesh& m)
+void checkNoNullAreasExist(const Mesh& m, ValidationLevel level)
 {
-    std::stringstream msg;
-    bool nullAreas = false;
-    for (const auto& g : m.groups) {
-        for (auto const& e: g.elements) {
+    if (level == ValidationLevel::None) {
+        return;
+    }
+
+    std::vector<std::vector<double>> areas;
+    areas.reserve(m.groups.size());
+    for (auto const& g : m.groups) {
+        areas.push_back(Geometry::areas(g.elements, m.coordinates));
+    }
+
+    checkNoElementsIf(m, level, "Invalid mesh invariant: Null areas exist.",
+        [&](auto const& g, auto const& e) {
             if (e.isNode()) {
-                continue;
+                return false;
             }
             if (e.isLine()) {
                 auto line = Geometry::asLinV(e, m.coordinates);
-                if ((line.back() - line.front()).norm() == 0.0) {
-                    nullAreas = true;
-                    msg << std::endl;
-                    msg << "Group: " << &g - &m.groups.front()
-                        << ", Element: " << &e - &g.elements.front() << std::endl;
-                    msg << info(e, m) << std::endl;
-                }
+                return (line.back() - line.front()).norm() == 0.0;
             }
-            else if (Geometry::area(Geometry::asTriV(e, m.coordinates)) == 0.0) {
-                nullAreas = true;
-                msg << std::endl;
-                msg << "Group: " << &g - &m.groups.front()
-                    << ", Element: " << &e - &g.elements.front() << std::endl;
-                msg << info(e, m) << std::endl;
+            if (e.isTriangle()) {
+                return areas[&g - &m.groups.front()][&e - &g.elements.front()] == 0.0;
             }
-        }
-    }
-    if (nullAreas) {
-        msg << std::endl << "Invalid mesh invariant: Null areas exist.";
-        throw std::runtime_error(msg.str());
-    }
+            return Geometry::area(Geometry::asTriV(e, m.coordinates)) == 0.0;
+        });
 }
 
 void convertToAbsoluteCoordinates(Mesh& m)
@@ -281,11 +395,88 @@ void convertToAbsoluteCoordinates(Mesh& m)
     );
 }
 
-void checkSlicedMeshInvariants(const Mesh& m)
+namespace {
+
+// Spreads the lower 21 bits of x so that there are two zero bits between them.
+std::uint64_t spreadBits(std::uint64_t x)
+{
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffff;
+    x = (x | x << 16) & 0x1f0000ff0000ff;
+    x = (x | x << 8) & 0x100f00f00f00f00f;
+    x = (x | x << 4) & 0x10c30c30c30c30c3;
+    x = (x | x << 2) & 0x1249249249249249;
+    return x;
+}
+
+std::uint64_t mortonCode(const Cell& cell, const Cell& origin)
+{
+    return spreadBits(cell(0) - origin(0)) |
+        spreadBits(cell(1) - origin(1)) << 1 |
+        spreadBits(cell(2) - origin(2)) << 2;
+}
+
+}
+
+void reorderSpatially(Mesh& m)
+{
+    if (m.coordinates.empty()) {
+        return;
+    }
+
+    Cell origin = GridTools::toCell(m.coordinates.front());
+    for (auto const& c : m.coordinates) {
+        const Cell cell = GridTools::toCell(c);
+        for (Axis d = 0; d < 3; d++) {
+            origin(d) = std::min(origin(d), cell(d));
+        }
+    }
+
+    std::vector<std::uint64_t> codes(m.coordinates.size());
+    for (std::size_t i = 0; i < m.coordinates.size(); i++) {
+        codes[i] = mortonCode(GridTools::toCell(m.coordinates[i]), origin);
+    }
+    std::vector<CoordinateId> order(m.coordinates.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&](auto const& a, auto const& b) { return codes[a] < codes[b]; });
+
+    Coordinates newCoords(m.coordinates.size());
+    std::vector<CoordinateId> newIds(m.coordinates.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        newCoords[i] = m.coordinates[order[i]];
+        newIds[order[i]] = i;
+    }
+    m.coordinates = std::move(newCoords);
+
+    for (auto& g : m.groups) {
+        std::vector<std::pair<std::uint64_t, ElementId>> elemCodes(g.elements.size());
+        for (std::size_t i = 0; i < g.elements.size(); i++) {
+            Element& e = g.elements[i];
+            Coordinate centroid;
+            for (auto& v : e.vertices) {
+                v = newIds[v];
+                centroid += m.coordinates[v] / double(e.vertices.size());
+            }
+            elemCodes[i] = std::make_pair(mortonCode(GridTools::toCell(centroid), origin), i);
+        }
+        std::stable_sort(elemCodes.begin(), elemCodes.end(),
+            [](auto const& a, auto const& b) { return a.first < b.first; });
+
+        Elements newElems;
+        newElems.reserve(g.elements.size());
+        for (auto const& code : elemCodes) {
+            newElems.push_back(std::move(g.elements[code.second]));
+        }
+        g.elements = std::move(newElems);
+    }
+}
+
+void checkSlicedMeshInvariants(const Mesh& m, ValidationLevel level)
 {
-    checkNoCellsAreCrossed(m);
-    checkNoOverlaps(m);
-    checkNoNullAreasExist(m);
+    checkNoCellsAreCrossed(m, level);
+    checkNoOverlaps(m, level);
+    checkNoNullAreasExist(m, level);
 }
 
 Mesh buildMeshFilteringElements(
@@ -2,6 +2,7 @@
 
 #include "types/Mesh.h"
 #include "utils/Types.h"
+#include "utils/ValidationLevel.h"
 
 
 namespace meshlib::utils::meshTools {
@@ -34,12 +35,17 @@ void reduceGrid(Mesh&, const Grid&);
 Mesh reduceGrid(const Mesh& m, const Grid& g);
 
 void convertToAbsoluteCoordinates(Mesh&);
+
+// Sorts coordinates and the elements of each group by the Morton code of their
+// cell, so that data of neighbouring cells is close in memory. Coordinates must
+// be relative to the grid.
+void reorderSpatially(Mesh&);
 	
-void checkSlicedMeshInvariants(Mesh& m);
+void checkSlicedMeshInvariants(const Mesh& m, ValidationLevel = ValidationLevel::Full);
 	
-void checkNoCellsAreCrossed(const Mesh& m);
-void checkNoOverlaps(const Mesh& m);
-void checkNoNullAreasExist(const Mesh& m);
+void checkNoCellsAreCrossed(const Mesh& m, ValidationLevel = ValidationLevel::Full);
+void checkNoOverlaps(const Mesh& m, ValidationLevel = ValidationLevel::Full);
+void checkNoNullAreasExist(const Mesh& m, ValidationLevel = ValidationLevel::Full);
 
 std::string info(const Element& e, const Mesh& m);
 
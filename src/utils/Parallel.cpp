@@ -0,0 +1,291 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#ifdef TESSELLATOR_USE_TBB
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
+namespace meshlib {
+namespace utils {
+
+namespace {
+
+std::atomic<ExecutionBackend> defaultBackend{ ExecutionBackend::Default };
+std::atomic<std::size_t> defaultNumberOfThreads{ 0 };
+
+thread_local ExecutionOptions threadExecution;
+thread_local bool insideParallelRegion = false;
+
+class ParallelRegion {
+public:
+    ParallelRegion() : previous_(insideParallelRegion) { insideParallelRegion = true; }
+    ~ParallelRegion() { insideParallelRegion = previous_; }
+
+private:
+    bool previous_;
+};
+
+void checkIsAvailable([[maybe_unused]] ExecutionBackend backend)
+{
+#ifndef TESSELLATOR_USE_TBB
+    if (backend == ExecutionBackend::TBB) {
+        throw std::runtime_error("TBB execution backend is not available in this build.");
+    }
+#endif
+}
+
+struct Job {
+    const std::function<void(std::size_t)>* chunk;
+    std::size_t numberOfChunks;
+    std::atomic<std::size_t> nextChunk{ 0 };
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+// Chunks are claimed one by one, so threads which finish early keep taking
+// work from the ones which got expensive chunks.
+void runJob(Job& job)
+{
+    ParallelRegion region;
+    for (;;) {
+        const std::size_t c = job.nextChunk.fetch_add(1);
+        if (c >= job.numberOfChunks) {
+            return;
+        }
+        try {
+            (*job.chunk)(c);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(job.errorMutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+            job.nextChunk = job.numberOfChunks;
+        }
+    }
+}
+
+// Workers are started on demand and live until the end of the process. The
+// calling thread takes chunks too, so a job uses the calling thread plus
+// numberOfThreads - 1 workers.
+class ThreadPool {
+public:
+    static ThreadPool& get()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wakeUp_.notify_all();
+        for (auto& w : workers_) {
+            w.join();
+        }
+    }
+
+    void run(std::size_t numberOfThreads, Job& job)
+    {
+        std::lock_guard<std::mutex> runLock(runMutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            helpers_ = std::min(numberOfThreads, job.numberOfChunks) - 1;
+            while (workers_.size() < helpers_) {
+                workers_.emplace_back(&ThreadPool::work_, this, workers_.size());
+            }
+            job_ = &job;
+            pending_ = helpers_;
+            generation_++;
+        }
+        wakeUp_.notify_all();
+
+        runJob(job);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        finished_.wait(lock, [&]() { return pending_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    std::vector<std::thread> workers_;
+
+    // Serializes jobs coming from different threads.
+    std::mutex runMutex_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable finished_;
+    Job* job_ = nullptr;
+    std::size_t helpers_ = 0;
+    std::size_t pending_ = 0;
+    std::size_t generation_ = 0;
+    bool stop_ = false;
+
+    void work_(std::size_t index)
+    {
+        std::size_t seenGeneration = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wakeUp_.wait(lock, [&]() { return stop_ || generation_ != seenGeneration; });
+            if (stop_) {
+                return;
+            }
+            seenGeneration = generation_;
+            if (index >= helpers_) {
+                continue;
+            }
+            Job* job = job_;
+            lock.unlock();
+            runJob(*job);
+            lock.lock();
+            if (--pending_ == 0) {
+                finished_.notify_one();
+            }
+        }
+    }
+};
+
+#ifdef TESSELLATOR_USE_TBB
+tbb::task_arena& getArena(std::size_t numberOfThreads)
+{
+    static std::mutex mutex;
+    static std::map<std::size_t, std::unique_ptr<tbb::task_arena>> arenas;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& arena = arenas[numberOfThreads];
+    if (!arena) {
+        arena = std::make_unique<tbb::task_arena>(int(numberOfThreads));
+    }
+    return *arena;
+}
+#endif
+
+}
+
+ExecutionBackend toExecutionBackend(const std::string& str)
+{
+    if (str == "serial") {
+        return ExecutionBackend::Serial;
+    }
+    if (str == "threads") {
+        return ExecutionBackend::Threads;
+    }
+    if (str == "tbb") {
+        return ExecutionBackend::TBB;
+    }
+    throw std::runtime_error("Unsupported execution backend: " + str);
+}
+
+void setDefaultExecution(const ExecutionOptions& opts)
+{
+    checkIsAvailable(opts.backend);
+    defaultBackend = opts.backend;
+    defaultNumberOfThreads = opts.numberOfThreads;
+}
+
+ExecutionOptions getExecution()
+{
+    ExecutionOptions res = threadExecution;
+    if (res.backend == ExecutionBackend::Default) {
+        res.backend = defaultBackend;
+    }
+    if (res.backend == ExecutionBackend::Default) {
+#ifdef TESSELLATOR_USE_TBB
+        res.backend = ExecutionBackend::TBB;
+#else
+        res.backend = ExecutionBackend::Serial;
+#endif
+    }
+    if (res.numberOfThreads == 0) {
+        res.numberOfThreads = defaultNumberOfThreads;
+    }
+    if (res.numberOfThreads == 0) {
+        res.numberOfThreads = std::max(std::size_t(1), std::size_t(std::thread::hardware_concurrency()));
+    }
+    return res;
+}
+
+ScopedExecution::ScopedExecution(const ExecutionOptions& opts) :
+    previous_(threadExecution)
+{
+    checkIsAvailable(opts.backend);
+    if (opts.backend != ExecutionBackend::Default) {
+        threadExecution.backend = opts.backend;
+    }
+    if (opts.numberOfThreads != 0) {
+        threadExecution.numberOfThreads = opts.numberOfThreads;
+    }
+}
+
+ScopedExecution::~ScopedExecution()
+{
+    threadExecution = previous_;
+}
+
+namespace detail {
+
+std::size_t numberOfChunks(std::size_t size)
+{
+    const std::size_t MAX_NUMBER_OF_CHUNKS = 256;
+    return std::min(size, MAX_NUMBER_OF_CHUNKS);
+}
+
+void runChunks(std::size_t numberOfChunks, const std::function<void(std::size_t)>& chunk)
+{
+    const ExecutionOptions opts = getExecution();
+    if (insideParallelRegion ||
+        numberOfChunks < 2 ||
+        opts.numberOfThreads < 2 ||
+        opts.backend == ExecutionBackend::Serial) {
+        for (std::size_t c = 0; c < numberOfChunks; c++) {
+            chunk(c);
+        }
+        return;
+    }
+
+    if (opts.backend == ExecutionBackend::TBB) {
+        checkIsAvailable(opts.backend);
+#ifdef TESSELLATOR_USE_TBB
+        getArena(opts.numberOfThreads).execute([&]() {
+            tbb::parallel_for(std::size_t(0), numberOfChunks, [&](std::size_t c) {
+                ParallelRegion region;
+                chunk(c);
+            });
+        });
+#endif
+        return;
+    }
+
+    Job job;
+    job.chunk = &chunk;
+    job.numberOfChunks = numberOfChunks;
+    ThreadPool::get().run(opts.numberOfThreads, job);
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+}
+
+void TaskGroup::wait()
+{
+    std::vector<std::function<void()>> tasks;
+    std::swap(tasks, tasks_);
+    detail::runChunks(tasks.size(), [&](std::size_t t) { tasks[t](); });
+}
+
+}
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace meshlib {
+namespace utils {
+
+// Backend used to run parallel loops and task groups.
+enum class ExecutionBackend {
+    // Uses the process-wide default backend.
+    Default,
+    // Runs everything in the calling thread.
+    Serial,
+    // Runs in a pool of std::threads owned by the library.
+    Threads,
+    // Runs in TBB. Only available when built with TESSELLATOR_USE_TBB.
+    TBB
+};
+
+struct ExecutionOptions {
+    ExecutionBackend backend = ExecutionBackend::Default;
+    // Maximum number of threads, including the calling one. Zero uses the
+    // process-wide default.
+    std::size_t numberOfThreads = 0;
+};
+
+ExecutionBackend toExecutionBackend(const std::string&);
+
+// Sets the options used by threads which have not overridden them with a
+// ScopedExecution. The initial default is TBB when available and Serial
+// otherwise, with as many threads as the hardware supports.
+// Results only stay independent of the backend and the number of threads
+// if the calls of each loop write disjoint data and do not read what other
+// calls write. Loops whose iterations depend on each other must stay serial.
+void setDefaultExecution(const ExecutionOptions&);
+
+// Resolved options of the calling thread, never Default nor zero threads.
+ExecutionOptions getExecution();
+
+// Overrides the execution options of the calling thread during its lifetime.
+// Fields left to Default or zero keep their current value.
+class ScopedExecution {
+public:
+    explicit ScopedExecution(const ExecutionOptions&);
+    ~ScopedExecution();
+
+    ScopedExecution(const ScopedExecution&) = delete;
+    ScopedExecution& operator=(const ScopedExecution&) = delete;
+
+private:
+    ExecutionOptions previous_;
+};
+
+namespace detail {
+
+// Calls chunk(c) for every c in [0, numberOfChunks) using the execution options
+// of the calling thread. Calls made while running a chunk are serial, so nested
+// loops never oversubscribe the threads. The first exception thrown by a chunk
+// is rethrown once all running chunks have finished.
+void runChunks(std::size_t numberOfChunks, const std::function<void(std::size_t)>& chunk);
+
+// Number of chunks in which a range is split. It only depends on the size of the
+// range so that reductions give the same result with any backend.
+std::size_t numberOfChunks(std::size_t size);
+
+inline std::size_t chunkBegin(std::size_t chunk, std::size_t numberOfChunks, std::size_t size)
+{
+    return chunk * size / numberOfChunks;
+}
+
+}
+
+// Calls f(i) for every i in [begin, end).
+template <class F>
+void parallelFor(std::size_t begin, std::size_t end, F&& f)
+{
+    if (end <= begin) {
+        return;
+    }
+    const std::size_t size = end - begin;
+    const std::size_t nChunks = detail::numberOfChunks(size);
+    detail::runChunks(nChunks, [&](std::size_t c) {
+        const std::size_t last = begin + detail::chunkBegin(c + 1, nChunks, size);
+        for (std::size_t i = begin + detail::chunkBegin(c, nChunks, size); i < last; i++) {
+            f(i);
+        }
+    });
+}
+
+// Calls f(*it) for every iterator in [first, last).
+template <class RandomIt, class F>
+void parallelForEach(RandomIt first, RandomIt last, F&& f)
+{
+    parallelFor(0, std::size_t(std::distance(first, last)), [&](std::size_t i) {
+        f(first[i]);
+    });
+}
+
+// Reduces map(i) for every i in [begin, end) starting from identity. The reduce
+// operation must be associative; partial results are combined in order.
+template <class T, class Map, class Reduce>
+T parallelReduce(std::size_t begin, std::size_t end, const T& identity, Map&& map, Reduce&& reduce)
+{
+    if (end <= begin) {
+        return identity;
+    }
+    const std::size_t size = end - begin;
+    const std::size_t nChunks = detail::numberOfChunks(size);
+    std::vector<T> partials(nChunks, identity);
+    detail::runChunks(nChunks, [&](std::size_t c) {
+        const std::size_t last = begin + detail::chunkBegin(c + 1, nChunks, size);
+        T partial = identity;
+        for (std::size_t i = begin + detail::chunkBegin(c, nChunks, size); i < last; i++) {
+            partial = reduce(std::move(partial), map(i));
+        }
+        partials[c] = std::move(partial);
+    });
+
+    T res = identity;
+    for (auto& partial : partials) {
+        res = reduce(std::move(res), std::move(partial));
+    }
+    return res;
+}
+
+// Collects tasks which are run concurrently by wait(). The first exception
+// thrown by a task is rethrown by wait() once the others have finished.
+class TaskGroup {
+public:
+    void run(std::function<void()> task) { tasks_.push_back(std::move(task)); }
+    void wait();
+
+private:
+    std::vector<std::function<void()>> tasks_;
+};
+
+}
+}
@@ -4,185 +4,265 @@
 #include "GridTools.h"
 
 #include "MeshTools.h"
+#include "FlatHashMap.h"
+#include "Parallel.h"
 
 #include <map>
 #include <set>
 #include <algorithm>
+#include <cassert>
+#include <limits>
+#include <type_traits>
 #include <unordered_set> 
 
+
 namespace meshlib {
 namespace utils {
 
-void RedundancyCleaner::removeRepeatedElementsIgnoringOrientation(Mesh& m)
+namespace {
+
+// Elements with up to this number of vertices are keyed with fixed-size arrays.
+constexpr std::size_t MAX_KEY_SIZE = 4;
+constexpr CoordinateId NO_ID = std::numeric_limits<CoordinateId>::max();
+
+using ElementKey = std::array<CoordinateId, MAX_KEY_SIZE>;
+using ElementKeySet = FlatHashSet<ElementKey, ArrayHash<CoordinateId, MAX_KEY_SIZE>>;
+using LineKeySet = FlatHashSet<LinIds, ArrayHash<CoordinateId, 2>>;
+using LineKeyMap = FlatHashMap<LinIds, ElementId, ArrayHash<CoordinateId, 2>>;
+
+template <class It>
+It rotateToMinimum(It begin, It end)
 {
-    std::vector<std::set<ElementId>> toRemove(m.groups.size());
-    for (const auto& g : m.groups) {
-        auto gId{ &g - &m.groups.front() };
-        std::map<IdSet, ElementId> vToE;
-        for (const auto& e : g.elements) {
-            auto eId{ &e - &g.elements.front() };
-            IdSet vIds{ e.vertices.begin(), e.vertices.end() };
-            if (vToE.count(vIds) == 0) {
-                vToE.emplace(vIds, eId);
-            }
-            else {
-                toRemove[gId].insert(eId);
-            }
+    if (std::distance(begin, end) > 2) {
+        std::rotate(begin, std::min_element(begin, end), end);
+    }
+    return end;
+}
+
+// Keys have at most MAX_KEY_SIZE entries, for which an insertion sort is
+// faster than std::sort. Using std::sort on them also makes the compiler warn
+// about out of bounds accesses in code paths for larger ranges.
+template <class It>
+void insertionSort(It begin, It end)
+{
+    for (It it = begin; it != end; ++it) {
+        for (It j = it; j != begin && *j < *(j - 1); --j) {
+            std::iter_swap(j, j - 1);
         }
     }
+}
 
-    removeElements(m, toRemove);
+template <class It>
+It sortAndRemoveRepeated(It begin, It end)
+{
+    if constexpr (std::is_same_v<It, ElementKey::iterator>) {
+        insertionSort(begin, end);
+    }
+    else {
+        std::sort(begin, end);
+    }
+    return std::unique(begin, end);
 }
 
-void RedundancyCleaner::removeRepeatedElements(Mesh& m)
+template <class It>
+ElementKey buildKey(It begin, It end)
 {
-    std::vector<std::set<ElementId>> toRemove(m.groups.size());
-    for (const auto& g : m.groups) {
-        auto gId{&g - &m.groups.front()};
-        std::map<CoordinateIds, ElementId> vToE;
-        for (const auto& e : g.elements) {
-            auto eId{ &e - &g.elements.front() };
+    assert(std::distance(begin, end) <= std::ptrdiff_t(MAX_KEY_SIZE));
+    ElementKey key;
+    std::fill(std::copy(begin, end, key.begin()), key.end(), NO_ID);
+    return key;
+}
+
+ElementKey buildRotatedKey(const Element& e)
+{
+    ElementKey key{ buildKey(e.vertices.begin(), e.vertices.end()) };
+    rotateToMinimum(key.begin(), key.begin() + e.vertices.size());
+    return key;
+}
+
+LinIds buildLineKey(CoordinateId v0, CoordinateId v1)
+{
+    if (v1 < v0) {
+        std::swap(v0, v1);
+    }
+    return { v0, v1 };
+}
+
+template <class Canonicalizer>
+IdSet findRepeatedElements(const Group& g, Canonicalizer canonicalize)
+{
+    IdSet res;
+    ElementKeySet keys(g.elements.size());
+    std::set<CoordinateIds> largeKeys;
+    for (const auto& e : g.elements) {
+        const ElementId eId = &e - &g.elements.front();
+        bool isNew;
+        if (e.vertices.size() <= MAX_KEY_SIZE) {
+            ElementKey key{ buildKey(e.vertices.begin(), e.vertices.end()) };
+            auto last = canonicalize(key.begin(), key.begin() + e.vertices.size());
+            std::fill(last, key.end(), NO_ID);
+            isNew = keys.insert(key);
+        }
+        else {
             CoordinateIds vIds{ e.vertices };
-            if (vIds.size() > 2) {
-                std::rotate(vIds.begin(), std::min_element(vIds.begin(), vIds.end()), vIds.end());
-            }
-            if (vToE.count(vIds) == 0) {
-                vToE.emplace(vIds, eId);
+            vIds.erase(canonicalize(vIds.begin(), vIds.end()), vIds.end());
+            if (vIds.size() <= MAX_KEY_SIZE) {
+                isNew = keys.insert(buildKey(vIds.begin(), vIds.end()));
             }
             else {
-                toRemove[gId].insert(eId);
+                isNew = largeKeys.insert(vIds).second;
             }
         }
+        if (!isNew) {
+            res.insert(eId);
+        }
     }
-
-    removeElements(m, toRemove);
+    return res;
 }
 
-void RedundancyCleaner::removeOverlappedDimensionZeroElementsAndIdenticalLines(Mesh & mesh)
+IdSet findOverlappedDimensionZeroElementsAndIdenticalLines(const Group& group)
 {
-    std::vector<std::set<ElementId>> toRemove(mesh.groups.size());
-
-    for (std::size_t g = 0; g < mesh.groups.size(); ++g) {
-        auto & group = mesh.groups[g];
-        std::set<CoordinateId> usedCoordinates;
-        std::vector<ElementId> nodesToCheck;
-
-        for (std::size_t e = 0; e < group.elements.size(); ++e){
-            auto& element = group.elements[e];
-            if(element.isLine()){
-                usedCoordinates.insert(element.vertices[0]);
-                usedCoordinates.insert(element.vertices[1]);
-            }
-            else if (element.isNode()){
-                nodesToCheck.push_back(e);
-            }
+    IdSet res;
+    FlatHashSet<CoordinateId> usedCoordinates(2 * group.elements.size());
+    std::vector<ElementId> nodesToCheck;
+
+    for (std::size_t e = 0; e < group.elements.size(); ++e) {
+        auto& element = group.elements[e];
+        if (element.isLine()) {
+            usedCoordinates.insert(element.vertices[0]);
+            usedCoordinates.insert(element.vertices[1]);
         }
-
-        for(auto e : nodesToCheck){
-            auto & node = group.elements[e];
-            if (usedCoordinates.count(node.vertices[0]) == 0){
-                usedCoordinates.insert(node.vertices[0]);
-            }
-            else{
-                toRemove[g].insert(e);
-            }
+        else if (element.isNode()) {
+            nodesToCheck.push_back(e);
         }
     }
 
-    removeElements(mesh, toRemove);
+    for (auto e : nodesToCheck) {
+        auto& node = group.elements[e];
+        if (!usedCoordinates.insert(node.vertices[0])) {
+            res.insert(e);
+        }
+    }
+    return res;
 }
 
-void RedundancyCleaner::removeOverlappedDimensionOneAndLowerElementsAndEquivalentSurfaces(Mesh & mesh)
+IdSet findOverlappedDimensionOneAndLowerElementsAndEquivalentSurfaces(
+    const Group& group, const Coordinates& coordinates)
 {
-    std::vector<std::set<ElementId>> toRemove(mesh.groups.size());
-
-    for (std::size_t g = 0; g < mesh.groups.size(); ++g) {
-        auto & group = mesh.groups[g];
-
-        std::set<CoordinateIds> usedCoordinatesFromSurface;
-        std::set<CoordinateIds> usedCoordinatePairsFromSurface;
-        std::set<CoordinateId> usedCoordinates;
-        std::vector<ElementId> linesToCheck;
-        std::vector<ElementId> nodesToCheck;
-
-        for (std::size_t e = 0; e < group.elements.size(); ++e){
-            auto& element = group.elements[e];
-            CoordinateIds vIds{ element.vertices };
-            if(vIds.size() >= 2){
-                std::rotate(vIds.begin(), std::min_element(vIds.begin(), vIds.end()), vIds.end());
-                for (std::size_t v = 0; v < vIds.size(); ++v){
-                    usedCoordinates.insert(vIds[v]);
-                }
+    IdSet res;
+
+    ElementKeySet usedCoordinatesFromSurface(group.elements.size());
+    LineKeySet usedCoordinatePairsFromSurface(3 * group.elements.size());
+    FlatHashSet<CoordinateId> usedCoordinates(group.elements.size());
+    std::vector<ElementId> linesToCheck;
+    std::vector<ElementId> nodesToCheck;
+
+    for (std::size_t e = 0; e < group.elements.size(); ++e) {
+        auto& element = group.elements[e];
+        if (element.vertices.size() >= 2) {
+            for (const auto& vId : element.vertices) {
+                usedCoordinates.insert(vId);
             }
-            if(element.isQuad() || element.isTriangle()){
-                if (usedCoordinatesFromSurface.count(vIds) == 0){
-                    usedCoordinatesFromSurface.insert(vIds);
-                    for (std::size_t v = 0; v < vIds.size(); ++v){
-                        auto firstCoordinateId = vIds[v];
-                        auto secondCoordinateId = vIds[(v + 1) % vIds.size()];
-
-                        if (secondCoordinateId < firstCoordinateId){
-                            std::swap(firstCoordinateId, secondCoordinateId);
-                        }
-                        usedCoordinatePairsFromSurface.insert({firstCoordinateId, secondCoordinateId});
-                    }
-                }
-                else{
-                    toRemove[g].insert(e);
+        }
+        if (element.isQuad() || element.isTriangle()) {
+            if (usedCoordinatesFromSurface.insert(buildRotatedKey(element))) {
+                const auto& vIds = element.vertices;
+                for (std::size_t v = 0; v < vIds.size(); ++v) {
+                    usedCoordinatePairsFromSurface.insert(
+                        buildLineKey(vIds[v], vIds[(v + 1) % vIds.size()]));
                 }
             }
-            else if (element.isLine()){
-                linesToCheck.push_back(e);
-            }
-            else if (element.isNode()){
-                nodesToCheck.push_back(e);
+            else {
+                res.insert(e);
             }
         }
-        
-        std::map<CoordinateIds, ElementId> usedCoordinatePairsFromLine;
+        else if (element.isLine()) {
+            linesToCheck.push_back(e);
+        }
+        else if (element.isNode()) {
+            nodesToCheck.push_back(e);
+        }
+    }
 
-        for (auto e : linesToCheck){
-            auto & line = group.elements[e];
-            CoordinateIds vIds{ line.vertices };
-            std::rotate(vIds.begin(), std::min_element(vIds.begin(), vIds.end()), vIds.end());
+    // When two lines overlap, the one with the greater direction sum is kept.
+    auto directionSum = [&](const Element& line) {
+        RelativeDir res = 0;
+        for (auto axis = X; axis <= Z; ++axis) {
+            res += coordinates[line.vertices[1]][axis] - coordinates[line.vertices[0]][axis];
+        }
+        return res;
+    };
 
-            if (usedCoordinatePairsFromSurface.count(vIds)){
-                toRemove[g].insert(e);
-            }
-            else if(usedCoordinatePairsFromLine.count(vIds) == 0){
-                    usedCoordinatePairsFromLine.emplace(vIds, e);
-            }
-            else{
-                auto & originalLine = group.elements[usedCoordinatePairsFromLine[vIds]];
-                RelativeDir direction = 0;
-                RelativeDir originalDirection = 0;
-                for (auto axis = X; axis <= Z; ++axis){
-                    direction += mesh.coordinates[line.vertices[1]][axis] - mesh.coordinates[line.vertices[0]][axis];
-                    originalDirection += mesh.coordinates[originalLine.vertices[1]][axis] - mesh.coordinates[originalLine.vertices[0]][axis];
-                }
+    LineKeyMap usedCoordinatePairsFromLine(linesToCheck.size());
+    for (auto e : linesToCheck) {
+        auto& line = group.elements[e];
+        const LinIds key{ buildLineKey(line.vertices[0], line.vertices[1]) };
 
-                if (direction > originalDirection){
-                    toRemove[g].insert(usedCoordinatePairsFromLine[vIds]);
-                    usedCoordinatePairsFromLine[vIds] = e;
-                }
-                else{
-                    toRemove[g].insert(e);
-                }
-            }
+        if (usedCoordinatePairsFromSurface.count(key)) {
+            res.insert(e);
+            continue;
+        }
+        
+        auto [originalId, inserted] = usedCoordinatePairsFromLine.emplace(key, e);
+        if (inserted) {
+            continue;
         }
+        if (directionSum(line) > directionSum(group.elements[*originalId])) {
+            res.insert(*originalId);
+            *originalId = e;
+        }
+        else {
+            res.insert(e);
+        }
+    }
 
-        for(auto e : nodesToCheck){
-            auto & node = group.elements[e];
-            if (usedCoordinates.count(node.vertices[0]) == 0){
-                usedCoordinates.insert(node.vertices[0]);
-            }
-            else{
-                toRemove[g].insert(e);
-            }
+    for (auto e : nodesToCheck) {
+        auto& node = group.elements[e];
+        if (!usedCoordinates.insert(node.vertices[0])) {
+            res.insert(e);
         }
     }
+    return res;
+}
+
+template <class GroupFinder>
+std::vector<IdSet> findInEachGroup(const Mesh& m, GroupFinder find)
+{
+    std::vector<IdSet> res(m.groups.size());
+    parallelFor(0, m.groups.size(), [&](std::size_t g) {
+        res[g] = find(m.groups[g]);
+    });
+    return res;
+}
+
+}
+
+void RedundancyCleaner::removeRepeatedElementsIgnoringOrientation(Mesh& m)
+{
+    removeElements(m, findInEachGroup(m, [](const Group& g) {
+        return findRepeatedElements(g, [](auto b, auto e) { return sortAndRemoveRepeated(b, e); });
+    }));
+}
 
-    removeElements(mesh, toRemove);
+void RedundancyCleaner::removeRepeatedElements(Mesh& m)
+{
+    removeElements(m, findInEachGroup(m, [](const Group& g) {
+        return findRepeatedElements(g, [](auto b, auto e) { return rotateToMinimum(b, e); });
+    }));
+}
+
+void RedundancyCleaner::removeOverlappedDimensionZeroElementsAndIdenticalLines(Mesh & mesh)
+{
+    removeElements(mesh, findInEachGroup(mesh, [](const Group& g) {
+        return findOverlappedDimensionZeroElementsAndIdenticalLines(g);
+    }));
+}
+
+void RedundancyCleaner::removeOverlappedDimensionOneAndLowerElementsAndEquivalentSurfaces(Mesh & mesh)
+{
+    removeElements(mesh, findInEachGroup(mesh, [&](const Group& g) {
+        return findOverlappedDimensionOneAndLowerElementsAndEquivalentSurfaces(g, mesh.coordinates);
+    }));
 }
 
 void RedundancyCleaner::removeElementsWithCondition(Mesh& m, std::function<bool(const Element&)> cnd)
@@ -205,12 +285,10 @@ Elements RedundancyCleaner::findDegenerateElements_(
     const Coordinates& coords)
 {
     Elements res;
-    for (const auto e : g.elements) {
-        if (!e.isTriangle()) {
-            continue;
-        }
-        if (Geometry::isDegenerate(Geometry::asTriV(e, coords))) {
-            res.push_back(e);
+    const std::vector<bool> degenerate = Geometry::areDegenerate(g.elements, coords);
+    for (std::size_t e = 0; e < g.elements.size(); e++) {
+        if (degenerate[e]) {
+            res.push_back(g.elements[e]);
         }
     }
     return res;
@@ -298,7 +376,7 @@ void RedundancyCleaner::removeElements(Mesh& mesh, const std::vector<IdSet>& toR
             }
         }
 
-        elems = newElems;       
+        elems = std::move(newElems);
     }
 }
 
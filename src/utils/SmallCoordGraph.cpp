@@ -0,0 +1,719 @@
+#include "SmallCoordGraph.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <assert.h>
+#include <set>
+
+namespace meshlib {
+namespace utils {
+
+SmallCoordGraph::LocalId SmallCoordGraph::findLocal_(const CoordinateId& id) const
+{
+    auto it = std::lower_bound(sorted_.begin(), sorted_.end(), id,
+        [&](LocalId v, const CoordinateId& id) { return ids_[v] < id; });
+    if (it == sorted_.end() || ids_[*it] != id) {
+        return NO_VERTEX;
+    }
+    return *it;
+}
+
+SmallCoordGraph::LocalId SmallCoordGraph::addLocal_(const CoordinateId& id)
+{
+    auto it = std::lower_bound(sorted_.begin(), sorted_.end(), id,
+        [&](LocalId v, const CoordinateId& id) { return ids_[v] < id; });
+    if (it != sorted_.end() && ids_[*it] == id) {
+        return *it;
+    }
+    LocalId v = LocalId(ids_.size());
+    ids_.push_back(id);
+    sorted_.insert(it, v);
+    return v;
+}
+
+SmallCoordGraph::EdgeRange SmallCoordGraph::getOutEdges_(LocalId v) const
+{
+    auto first = std::lower_bound(outEdges_.begin(), outEdges_.end(), v,
+        [&](LocalId e, LocalId v) { return edges_[e].source < v; });
+    auto last = first;
+    while (last != outEdges_.end() && edges_[*last].source == v) {
+        ++last;
+    }
+    return { first, last };
+}
+
+void SmallCoordGraph::buildOutEdges_()
+{
+    outEdges_.resize(edges_.size());
+    for (LocalId e = 0; e < edges_.size(); e++) {
+        outEdges_[e] = e;
+    }
+    std::stable_sort(outEdges_.begin(), outEdges_.end(),
+        [&](LocalId a, LocalId b) { return edges_[a].source < edges_[b].source; });
+}
+
+bool SmallCoordGraph::hasEdge_(LocalId source, LocalId target) const
+{
+    auto range = getOutEdges_(source);
+    return std::any_of(range.first, range.second,
+        [&](LocalId e) { return edges_[e].target == target; });
+}
+
+IdSet SmallCoordGraph::getVertices() const
+{
+    return IdSet(ids_.begin(), ids_.end());
+}
+
+std::vector<CoordinateId> SmallCoordGraph::getOrderedVertices() const
+{
+    return std::vector<CoordinateId>(ids_.begin(), ids_.end());
+}
+
+// Components are built as the depth first search trees following out edges
+// from each vertex in order, as connected_components does for CoordGraph.
+std::pair<std::vector<std::size_t>, std::size_t> SmallCoordGraph::findComponents_() const
+{
+    const std::size_t noComponent = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> component(ids_.size(), noComponent);
+    std::size_t num = 0;
+    std::vector<LocalId> stack;
+    for (LocalId start = 0; start < ids_.size(); start++) {
+        if (component[start] != noComponent) {
+            continue;
+        }
+        component[start] = num;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            LocalId v = stack.back();
+            stack.pop_back();
+            auto range = getOutEdges_(v);
+            for (auto e = range.first; e != range.second; ++e) {
+                LocalId w = edges_[*e].target;
+                if (component[w] == noComponent) {
+                    component[w] = num;
+                    stack.push_back(w);
+                }
+            }
+        }
+        num++;
+    }
+    return { component, num };
+}
+
+bool SmallCoordGraph::canBeSplit() const
+{
+    return findComponents_().second > 1;
+}
+
+std::vector<SmallCoordGraph> SmallCoordGraph::split() const
+{
+    if (ids_.empty()) {
+        return {};
+    }
+
+    std::vector<std::size_t> component;
+    std::size_t num;
+    std::tie(component, num) = findComponents_();
+    if (num == 1) {
+        return { *this };
+    }
+
+    std::vector<SmallCoordGraph> res(num);
+    for (auto const& e : edges_) {
+        if (component[e.source] == component[e.target]) {
+            res[component[e.source]].addEdge(ids_[e.source], ids_[e.target]);
+        }
+    }
+    return res;
+}
+
+SmallCoordGraph::SmallCoordGraph(const Elements& elems)
+{
+    std::vector<const Element*> elemPtrs;
+    elemPtrs.reserve(elems.size());
+    for (auto const& e : elems) {
+        elemPtrs.push_back(&e);
+    }
+    *this = SmallCoordGraph(elemPtrs);
+}
+
+SmallCoordGraph::SmallCoordGraph(const ElementsView& es)
+{
+    for (auto const& e : es) {
+        for (std::size_t i = 0; i < e->vertices.size(); i++) {
+            this->addEdge(
+                e->vertices[i],
+                e->vertices[(i + 1) % e->vertices.size()]
+            );
+            if (e->vertices.size() <= 2) {
+                break;
+            }
+        }
+    }
+}
+
+SmallCoordGraph::SmallCoordGraph(const Paths& paths) {
+    for (const auto& p : paths) {
+        for (std::size_t i = 0; i < p.size(); i++) {
+            this->addEdge(
+                p[i],
+                p[(i + 1) % p.size()]
+            );
+            if (p.size() <= 2) {
+                break;
+            }
+        }
+    }
+}
+
+void SmallCoordGraph::addVertex(const CoordinateId& id)
+{
+    addLocal_(id);
+}
+
+void SmallCoordGraph::addEdge(const CoordinateId& id1, const CoordinateId& id2)
+{
+    if (id1 == id2) {
+        throw std::runtime_error("Edges starting and finishing in same vertex are not allowed.");
+    }
+
+    Edge e{ addLocal_(id1), addLocal_(id2) };
+    auto it = std::upper_bound(outEdges_.begin(), outEdges_.end(), e.source,
+        [&](LocalId source, LocalId e) { return source < edges_[e].source; });
+    outEdges_.insert(it, LocalId(edges_.size()));
+    edges_.push_back(e);
+}
+
+void SmallCoordGraph::removeVertex(const CoordinateId& id)
+{
+    LocalId v = findLocal_(id);
+    if (v == NO_VERTEX) {
+        return;
+    }
+
+    auto renumber = [&](LocalId u) { return u > v ? u - 1 : u; };
+    auto last = std::remove_if(edges_.begin(), edges_.end(),
+        [&](const Edge& e) { return e.source == v || e.target == v; });
+    edges_.erase(last, edges_.end());
+    for (auto& e : edges_) {
+        e = { renumber(e.source), renumber(e.target) };
+    }
+    buildOutEdges_();
+
+    ids_.erase(ids_.begin() + v);
+    sorted_.erase(std::find(sorted_.begin(), sorted_.end(), v));
+    for (auto& u : sorted_) {
+        u = renumber(u);
+    }
+}
+
+void SmallCoordGraph::removeEdge(const CoordinateId& id1, const CoordinateId& id2)
+{
+    if (id1 == id2) {
+        throw std::runtime_error("Edges starting and finishing in same vertex are not allowed.");
+    }
+
+    LocalId v1 = findLocal_(id1);
+    LocalId v2 = findLocal_(id2);
+    if (v1 == NO_VERTEX || v2 == NO_VERTEX) {
+        return;
+    }
+    auto last = std::remove_if(edges_.begin(), edges_.end(),
+        [&](const Edge& e) { return e.source == v1 && e.target == v2; });
+    edges_.erase(last, edges_.end());
+    buildOutEdges_();
+}
+
+IdSet SmallCoordGraph::getAdjacentVertices(const CoordinateId id) const
+{
+    IdSet res;
+    LocalId v = findLocal_(id);
+    if (v == NO_VERTEX) {
+        return res;
+    }
+    for (auto const& e : edges_) {
+        if (e.source == v) {
+            res.insert(ids_[e.target]);
+        }
+        if (e.target == v) {
+            res.insert(ids_[e.source]);
+        }
+    }
+    return res;
+}
+
+IdSet SmallCoordGraph::getInterior() const
+{
+    IdSet interior;
+    for (auto const& v : getVertices()) {
+        IdSet adjVertices = getAdjacentVertices(v);
+        if (adjVertices.size() == 0 || adjVertices.size() == 1) {
+            continue;
+        } else if (adjVertices.size() == 2) {
+            interior.insert(v);
+        } else {
+            throw std::runtime_error("getInterior @ SmallCoordGraph: cannot find interior");
+        }
+    }
+    return interior;
+}
+
+IdSet SmallCoordGraph::getExterior() const
+{
+    IdSet exterior;
+    for (auto const& v : getVertices()) {
+        IdSet adjVertices = getAdjacentVertices(v);
+        if (adjVertices.size() == 0 || adjVertices.size() == 1) {
+            exterior.insert(v);
+        } else if (adjVertices.size() == 2) {
+            continue;
+        }
+        else {
+            throw std::runtime_error("getExterior @ SmallCoordGraph: cannot find exterior");
+        }
+    }
+    return exterior;
+}
+
+IdSet SmallCoordGraph::getClosestVerticesInSet(
+    const CoordinateId& vI,
+    const IdSet& ids) const
+{
+    assert(ids.count(vI) == 0);
+
+    struct cmp {
+        bool operator() (const Path& a, const Path& b) const {
+            if (a.size() < b.size()) {
+                return true;
+            }
+            else if (a.size() == b.size()) {
+                return a < b;
+            }
+            else {
+                return false;
+            }
+        }
+    };
+
+    std::set<Path, cmp> paths;
+    for (auto const& vB : ids) {
+        if (findLocal_(vB) == NO_VERTEX) {
+            continue;
+        }
+        auto path = findShortestPath(vI, vB);
+        if (path.empty()) {
+            throw std::runtime_error("Can not find path to point in set.");
+        }
+        paths.insert(path);
+    }
+
+    if (paths.empty()) {
+        return {};
+    }
+
+    const std::size_t shortestPathSize = paths.begin()->size();
+    IdSet res;
+    for (auto const& path : paths) {
+        if (path.size() == shortestPathSize) {
+            res.insert(path.back());
+        }
+        else {
+            break;
+        }
+    }
+    return res;
+}
+
+bool SmallCoordGraph::isOrientableAndCyclic(const Path& path) const
+{
+    if (path.empty()) {
+        return false;
+    }
+    if (isForwardOriented(path) || isForwardOriented(Path(path.rbegin(), path.rend()))) {
+        IdSet idsInPath(path.begin(), path.end());
+        LocalId v = findLocal_(*idsInPath.begin());
+        while (!idsInPath.empty()) {
+            bool nextVertexFound = false;
+            auto range = getOutEdges_(v);
+            for (auto e = range.first; e != range.second; ++e) {
+                auto tgtId = ids_[edges_[*e].target];
+                if (idsInPath.count(tgtId)) {
+                    nextVertexFound = true;
+                    v = edges_[*e].target;
+                    idsInPath.erase(tgtId);
+                    break;
+                }
+            }
+
+            if (!nextVertexFound) {
+                return false;
+            }
+        }
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+IdSet SmallCoordGraph::getExtremes() const
+{
+    IdSet extremes;
+    for (auto const& vId : ids_) {
+        if (getAdjacentVertices(vId).size() == 1) {
+            extremes.insert(vId);
+        }
+    }
+    return extremes;
+}
+
+SmallCoordGraph::Paths SmallCoordGraph::removeRepeated(const Paths& paths)
+{
+    std::map<std::set<CoordinateId>, Path> auxMaps;
+    for (auto const& path : paths) {
+        std::set<CoordinateId> key(path.begin(), path.end());
+        if (auxMaps.find(key) == auxMaps.end()) {
+            auxMaps.emplace(key, path);
+        }
+    }
+
+    Paths res;
+    for (auto const& auxMap : auxMaps) {
+        res.push_back(auxMap.second);
+    }
+    return res;
+}
+
+SmallCoordGraph::Path SmallCoordGraph::orderByOrientation(const Path& path) const
+{
+    if (isForwardOriented(path)) {
+        return path;
+    }
+
+    Path reversePath(path.rbegin(), path.rend());
+    if (isForwardOriented(reversePath)) {
+        return reversePath;
+    }
+
+    throw std::runtime_error("Unable to order path by orientation.");
+}
+
+bool SmallCoordGraph::isForwardOriented(const Path& path) const
+{
+    for (auto it = path.begin(); it != path.end(); ++it) {
+        if (it + 1 == path.end()) {
+            return true;
+        }
+
+        LocalId v = findLocal_(*it);
+        LocalId next = findLocal_(*(it + 1));
+        if (v == NO_VERTEX || next == NO_VERTEX || !hasEdge_(v, next)) {
+            return false;
+        }
+    }
+    throw std::runtime_error("Unable to determine if path is forward oriented.");
+}
+
+std::set<SmallCoordGraph::EdgeIds> SmallCoordGraph::getAcyclicEdges() const
+{
+    IdSet inCycles;
+    for (auto const& cycle : findCycles()) {
+        inCycles.insert(cycle.begin(), cycle.end());
+    }
+
+    std::set<EdgeIds> res;
+    for (auto const& e : edges_) {
+        auto src = ids_[e.source];
+        auto tgt = ids_[e.target];
+        if (inCycles.count(src) && inCycles.count(tgt)) {
+            continue;
+        }
+        res.insert({ src, tgt });
+    }
+    return res;
+}
+
+SmallCoordGraph::Paths SmallCoordGraph::findAcyclicPaths() const
+{
+    IdSet inCycles;
+    for (auto const& cycle : findCycles()) {
+        inCycles.insert(cycle.begin(), cycle.end());
+    }
+
+    std::vector<Path> paths;
+    for (auto const& extreme : getExtremes()) {
+        paths.push_back({});
+        bool isNeighExtreme = false;
+        bool isNeighInCycle = false;
+        CoordinateId currentId = extreme;
+        IdSet visited;
+        while (!isNeighExtreme && !isNeighInCycle) {
+            paths.back().push_back(currentId);
+            visited.insert(currentId);
+
+            CoordinateId neighId = ids_.front();
+            for (auto const& adj : getAdjacentVertices(currentId)) {
+                if (visited.count(adj) != 1) {
+                    neighId = adj;
+                    break;
+                }
+            }
+
+            isNeighExtreme = getAdjacentVertices(neighId).size() == 1;
+            isNeighInCycle = inCycles.count(neighId) > 0;
+            if (isNeighExtreme || isNeighInCycle) {
+                paths.back().push_back(neighId);
+            }
+            currentId = neighId;
+        }
+    }
+
+    return removeRepeated(paths);
+}
+
+std::pair<IdSet, IdSet> SmallCoordGraph::getBoundAndInteriorVertices() const
+{
+    IdSet all = getVertices();
+    IdSet bound = getBoundaryGraph().getVertices();
+    IdSet interior;
+    std::set_difference(
+        all.begin(), all.end(),
+        bound.begin(), bound.end(),
+        std::inserter(interior, interior.begin())
+    );
+    return std::make_pair(bound, interior);
+}
+
+SmallCoordGraph SmallCoordGraph::getBoundaryGraph() const
+{
+    SmallCoordGraph res;
+    for (auto const& e : edges_) {
+        if (!hasEdge_(e.target, e.source)) {
+            res.addEdge(ids_[e.source], ids_[e.target]);
+        }
+    }
+    return res;
+}
+
+SmallCoordGraph SmallCoordGraph::getInternalGraph() const
+{
+    return difference(getBoundaryGraph());
+}
+
+SmallCoordGraph SmallCoordGraph::difference(const SmallCoordGraph& rhs) const
+{
+    SmallCoordGraph diff = *this;
+    for (auto const& e : rhs.edges_) {
+        diff.removeEdge(rhs.ids_[e.source], rhs.ids_[e.target]);
+    }
+
+    SmallCoordGraph res;
+    for (auto const& e : diff.edges_) {
+        res.addEdge(diff.ids_[e.source], diff.ids_[e.target]);
+    }
+    return res;
+}
+
+SmallCoordGraph SmallCoordGraph::intersect(const SmallCoordGraph& rhs) const
+{
+    return intersect(rhs.getVertices());
+}
+
+// Edges are traversed in both directions. Vertices are visited in the same
+// order as the zero weight dijkstra search used by CoordGraph so that both
+// return the same path when several are possible: the next vertex to visit
+// is the first one in the queue, which is then replaced by the last one.
+SmallCoordGraph::Path SmallCoordGraph::findShortestPath(
+    const CoordinateId& ini,
+    const CoordinateId& end) const
+{
+    const std::size_t n = ids_.size();
+    std::vector<std::size_t> offsets(n + 1, 0);
+    for (auto const& e : edges_) {
+        offsets[e.source + 1]++;
+        offsets[e.target + 1]++;
+    }
+    std::size_t connected = 0;
+    for (std::size_t v = 0; v < n; v++) {
+        if (offsets[v + 1] != 0) {
+            connected++;
+        }
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<LocalId> adjacent(offsets.back());
+    {
+        std::vector<std::size_t> pos(offsets.begin(), offsets.end() - 1);
+        for (auto const& e : edges_) {
+            adjacent[pos[e.source]++] = e.target;
+            adjacent[pos[e.target]++] = e.source;
+        }
+    }
+
+    LocalId startVertex = findLocal_(ini);
+    LocalId endVertex = findLocal_(end);
+    if (startVertex == NO_VERTEX || endVertex == NO_VERTEX) {
+        return Path();
+    }
+
+    std::vector<LocalId> predecessors(n);
+    std::vector<char> discovered(n, false);
+    for (LocalId v = 0; v < n; v++) {
+        predecessors[v] = v;
+    }
+    std::vector<LocalId> queue{ startVertex };
+    discovered[startVertex] = true;
+    while (!queue.empty()) {
+        LocalId u = queue.front();
+        queue.front() = queue.back();
+        queue.pop_back();
+        for (std::size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+            LocalId v = adjacent[i];
+            if (!discovered[v]) {
+                discovered[v] = true;
+                predecessors[v] = u;
+                queue.push_back(v);
+            }
+        }
+    }
+
+    Path reverse;
+    LocalId currentVertex = endVertex;
+    while (currentVertex != startVertex) {
+        reverse.push_back(ids_[currentVertex]);
+        currentVertex = predecessors[currentVertex];
+        if (reverse.size() > connected) {
+            return Path({});
+        }
+    }
+    reverse.push_back(ids_[startVertex]);
+
+    return Path(reverse.rbegin(), reverse.rend());
+}
+
+std::vector<SmallCoordGraph> SmallCoordGraph::buildFromElementsViews(
+    const std::vector<ElementsView>& esVs)
+{
+    std::vector<SmallCoordGraph> res;
+    res.reserve(esVs.size());
+    for (auto const& esV : esVs) {
+        res.push_back(SmallCoordGraph(esV));
+    }
+    return res;
+}
+
+Elements SmallCoordGraph::getEdgesAsLines() const
+{
+    Elements res;
+    res.reserve(edges_.size());
+    for (auto const& e : edges_) {
+        Element line;
+        line.type = Element::Type::Line;
+        line.vertices = { ids_[e.source], ids_[e.target] };
+        res.push_back(line);
+    }
+    return res;
+}
+
+bool SmallCoordGraph::isUnionOfSimpleCycles() const
+{
+    std::vector<std::size_t> outDegree(ids_.size(), 0), inDegree(ids_.size(), 0);
+    for (auto const& e : edges_) {
+        outDegree[e.source]++;
+        inDegree[e.target]++;
+    }
+    for (std::size_t v = 0; v < ids_.size(); v++) {
+        if (outDegree[v] != 1 || inDegree[v] != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Each cycle starts at its first vertex and follows the only out edge of each
+// vertex, as the general enumeration would do. Runs in linear time.
+SmallCoordGraph::Paths SmallCoordGraph::findSimpleCycles(std::size_t maxCycles) const
+{
+    std::vector<LocalId> next(ids_.size());
+    for (auto const& e : edges_) {
+        next[e.source] = e.target;
+    }
+
+    Paths res;
+    std::vector<char> visited(ids_.size(), false);
+    for (LocalId v = 0; v < ids_.size() && res.size() < maxCycles; v++) {
+        if (visited[v]) {
+            continue;
+        }
+        res.push_back({});
+        LocalId u = v;
+        do {
+            visited[u] = true;
+            res.back().push_back(ids_[u]);
+            u = next[u];
+        } while (u != v);
+    }
+    return res;
+}
+
+// Other graphs are enumerated with Tiernan's algorithm, visiting vertices and
+// edges in the same order as boost::tiernan_all_cycles does for CoordGraph.
+SmallCoordGraph::Paths SmallCoordGraph::findCycles(std::size_t maxCycles) const
+{
+    if (isUnionOfSimpleCycles()) {
+        return findSimpleCycles(maxCycles);
+    }
+
+    const std::size_t n = ids_.size();
+    Paths res;
+    std::vector<LocalId> path;
+    std::vector<char> inPath(n, false);
+    // closed[u * n + v] is true when v has been closed to u.
+    std::vector<char> closed(n * n, false);
+
+    auto extendPath = [&]() {
+        LocalId u = path.back();
+        auto range = getOutEdges_(u);
+        for (auto e = range.first; e != range.second; ++e) {
+            LocalId v = edges_[*e].target;
+            if (path.front() < v && !inPath[v] && !closed[u * n + v]) {
+                path.push_back(v);
+                inPath[v] = true;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    for (LocalId start = 0; start < n && res.size() < maxCycles; start++) {
+        path.assign(1, start);
+        inPath[start] = true;
+        while (true) {
+            while (extendPath()) {}
+
+            if (path.size() >= 2 && hasEdge_(path.back(), path.front())) {
+                res.emplace_back();
+                for (auto const& v : path) {
+                    res.back().push_back(ids_[v]);
+                }
+                if (res.size() >= maxCycles) {
+                    break;
+                }
+            }
+
+            if (path.size() == 1) {
+                break;
+            }
+            LocalId last = path.back();
+            path.pop_back();
+            inPath[last] = false;
+            std::fill(closed.begin() + last * n, closed.begin() + (last + 1) * n, false);
+            closed[path.back() * n + last] = true;
+        }
+        inPath[start] = false;
+        std::fill(closed.begin() + start * n, closed.begin() + (start + 1) * n, false);
+    }
+    return res;
+}
+
+}
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "types/Mesh.h"
+#include "Types.h"
+#include "Tools.h"
+
+#include <boost/container/small_vector.hpp>
+
+#include <cstdint>
+#include <limits>
+
+namespace meshlib {
+namespace utils {
+
+// Directed graph of coordinate ids with the same interface and results as
+// CoordGraph. It is meant for the small graphs built for each cell or patch:
+// vertices and edges are kept in flat arrays with inline storage, so graphs
+// with up to INLINE_VERTICES vertices and INLINE_EDGES edges do not allocate.
+class SmallCoordGraph {
+public:
+    typedef std::pair<CoordinateId, CoordinateId> EdgeIds;
+    typedef std::vector<CoordinateId> Path;
+    typedef std::vector<Path> Paths;
+
+    SmallCoordGraph() = default;
+    SmallCoordGraph(const Elements& elems);
+    SmallCoordGraph(const ElementsView& elems);
+    SmallCoordGraph(const Paths& paths);
+
+    void addVertex(const CoordinateId& id);
+    void addEdge(const CoordinateId& id1, const CoordinateId& id2);
+    void removeVertex(const CoordinateId& id);
+    void removeEdge(const CoordinateId& id1, const CoordinateId& id2);
+    std::size_t verticesSize() const { return ids_.size(); }
+    std::size_t edgesSize() const { return edges_.size(); }
+
+    std::vector<SmallCoordGraph> split() const;
+
+    IdSet getVertices() const;
+    std::vector<CoordinateId> getOrderedVertices() const;
+    IdSet getAdjacentVertices(const CoordinateId id) const;
+    IdSet getInterior() const;
+    IdSet getExterior() const;
+    std::pair<IdSet, IdSet> getBoundAndInteriorVertices() const;
+
+    IdSet getClosestVerticesInSet(const CoordinateId& id, const IdSet& coordSet) const;
+
+    // Cycles are found by following edges when each vertex has a single
+    // in and out edge. Otherwise all elementary cycles are enumerated, stopping
+    // after finding maxCycles.
+    Paths findCycles(std::size_t maxCycles = std::numeric_limits<std::size_t>::max()) const;
+    bool isOrientableAndCyclic(const Path&) const;
+
+    Paths findAcyclicPaths() const;
+    std::set<EdgeIds> getAcyclicEdges() const;
+    Path orderByOrientation(const Path&) const;
+    Path findShortestPath(const CoordinateId& ini, const CoordinateId& end) const;
+
+    SmallCoordGraph getBoundaryGraph() const;
+    SmallCoordGraph getInternalGraph() const;
+    SmallCoordGraph intersect(const SmallCoordGraph& rhs) const;
+    template<typename Container> SmallCoordGraph intersect(const Container& rhs) const;
+    SmallCoordGraph difference(const SmallCoordGraph& rhs) const;
+    Elements getEdgesAsLines() const;
+
+    static std::vector<SmallCoordGraph> buildFromElementsViews(
+        const std::vector<ElementsView>& esV);
+    bool canBeSplit() const;
+
+private:
+    typedef std::uint32_t LocalId;
+    struct Edge {
+        LocalId source;
+        LocalId target;
+    };
+
+    static constexpr std::size_t INLINE_VERTICES = 16;
+    static constexpr std::size_t INLINE_EDGES = 48;
+    static constexpr LocalId NO_VERTEX = std::numeric_limits<LocalId>::max();
+
+    typedef boost::container::small_vector<LocalId, INLINE_EDGES> EdgeIndices;
+    typedef std::pair<EdgeIndices::const_iterator, EdgeIndices::const_iterator> EdgeRange;
+
+    // Coordinate ids in order of insertion, indexed by local id.
+    boost::container::small_vector<CoordinateId, INLINE_VERTICES> ids_;
+    // Local ids sorted by coordinate id.
+    boost::container::small_vector<LocalId, INLINE_VERTICES> sorted_;
+    // Edges in order of insertion.
+    boost::container::small_vector<Edge, INLINE_EDGES> edges_;
+    // Positions in edges_ sorted by source and then by insertion order.
+    EdgeIndices outEdges_;
+
+    LocalId findLocal_(const CoordinateId& id) const;
+    LocalId addLocal_(const CoordinateId& id);
+    EdgeRange getOutEdges_(LocalId v) const;
+    void buildOutEdges_();
+    bool hasEdge_(LocalId source, LocalId target) const;
+    std::pair<std::vector<std::size_t>, std::size_t> findComponents_() const;
+
+    IdSet getExtremes() const;
+    bool isUnionOfSimpleCycles() const;
+    Paths findSimpleCycles(std::size_t maxCycles) const;
+
+    static Paths removeRepeated(const Paths&);
+    bool isForwardOriented(const Path&) const;
+};
+
+template<typename Container>
+SmallCoordGraph SmallCoordGraph::intersect(const Container& rhs) const
+{
+    SmallCoordGraph res;
+    IdSet intersection = intersectWithIdSet(getVertices(), rhs);
+
+    for (auto const& id : intersection) {
+        res.addVertex(id);
+        auto range = getOutEdges_(findLocal_(id));
+        for (auto e = range.first; e != range.second; ++e) {
+            auto id2 = ids_[edges_[*e].target];
+            if (intersection.count(id2)) {
+                res.addEdge(id, id2);
+            }
+        }
+    }
+
+    return res;
+}
+
+}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace meshlib {
+namespace utils {
+
+// Disjoint sets of indices in [0, size) with path halving and union by size.
+class UnionFind {
+public:
+    UnionFind(std::size_t size = 0) :
+        parent_(size),
+        size_(size, 1)
+    {
+        std::iota(parent_.begin(), parent_.end(), 0);
+    }
+
+    std::size_t size() const { return parent_.size(); }
+
+    std::size_t find(std::size_t i)
+    {
+        while (parent_[i] != i) {
+            parent_[i] = parent_[parent_[i]];
+            i = parent_[i];
+        }
+        return i;
+    }
+
+    // Returns true if both indices were in different sets.
+    bool unite(std::size_t i, std::size_t j)
+    {
+        i = find(i);
+        j = find(j);
+        if (i == j) {
+            return false;
+        }
+        if (size_[i] < size_[j]) {
+            std::swap(i, j);
+        }
+        parent_[j] = i;
+        size_[i] += size_[j];
+        return true;
+    }
+
+    // Labels each index with the number of its set and returns the number of
+    // sets. Sets are numbered in order of their smallest index.
+    std::pair<std::vector<std::size_t>, std::size_t> labels()
+    {
+        const std::size_t noLabel = parent_.size();
+        std::vector<std::size_t> rootLabel(parent_.size(), noLabel);
+        std::vector<std::size_t> res(parent_.size());
+        std::size_t numberOfSets = 0;
+        for (std::size_t i = 0; i < parent_.size(); i++) {
+            std::size_t& label = rootLabel[find(i)];
+            if (label == noLabel) {
+                label = numberOfSets++;
+            }
+            res[i] = label;
+        }
+        return { res, numberOfSets };
+    }
+
+private:
+    std::vector<std::size_t> parent_;
+    std::vector<std::size_t> size_;
+};
+
+}
+}
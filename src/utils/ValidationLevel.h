@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+namespace meshlib::utils {
+
+// How thoroughly mesh invariants are checked after each meshing stage.
+enum class ValidationLevel {
+    // Invariants are not checked.
+    None,
+    // Checks stop at the first element breaking an invariant. Checks which
+    // need element adjacencies are skipped.
+    Cheap,
+    // All elements breaking an invariant are reported.
+    Full
+};
+
+inline ValidationLevel toValidationLevel(const std::string& str)
+{
+    if (str == "none") {
+        return ValidationLevel::None;
+    }
+    if (str == "cheap") {
+        return ValidationLevel::Cheap;
+    }
+    if (str == "full") {
+        return ValidationLevel::Full;
+    }
+    throw std::runtime_error("Unsupported validation level: " + str);
+}
+
+}
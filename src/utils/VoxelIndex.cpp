@@ -0,0 +1,183 @@
+#include "VoxelIndex.h"
+
+#include <algorithm>
+#include <bitset>
+#include <stdexcept>
+
+namespace meshlib {
+namespace utils {
+
+VoxelIndex::VoxelIndex(const GridTools& gT, const Elements& elems, const Coordinates& coords) :
+    gT_(gT)
+{
+    elementCells_.reserve(elems.size());
+    for (auto const& e : elems) {
+        insert(e, coords);
+    }
+}
+
+void VoxelIndex::insert(const Element& e, const Coordinates& coords)
+{
+    const ElementId id = elementCells_.size();
+    elementCells_.push_back(buildElementCells_(e, coords));
+    for (auto const& cell : elementCells_.back()) {
+        add_(id, cell);
+    }
+}
+
+void VoxelIndex::erase(const IdSet& elementIds)
+{
+    for (auto const& id : elementIds) {
+        if (id >= elementCells_.size()) {
+            throw std::runtime_error("Element is not in voxel index.");
+        }
+        for (auto const& cell : elementCells_[id]) {
+            remove_(id, cell);
+        }
+    }
+
+    // Ids are renumbered in increasing order, so lists remain sorted.
+    std::vector<ElementCells> newElementCells;
+    newElementCells.reserve(elementCells_.size() - elementIds.size());
+    auto it = elementIds.begin();
+    for (ElementId id = 0; id < elementCells_.size(); id++) {
+        if (it != elementIds.end() && *it == id) {
+            ++it;
+            continue;
+        }
+        const ElementId newId = newElementCells.size();
+        for (auto const& cell : elementCells_[id]) {
+            Brick& brick = *bricks_.find(toBrickKey_(cell));
+            auto& ids = brick.elementIds[rank_(brick, toPositionInBrick_(cell))];
+            *std::lower_bound(ids.begin(), ids.end(), id) = newId;
+        }
+        newElementCells.push_back(std::move(elementCells_[id]));
+    }
+    elementCells_ = std::move(newElementCells);
+}
+
+bool VoxelIndex::isOccupied(const Cell& cell) const
+{
+    const Brick* brick = bricks_.find(toBrickKey_(cell));
+    return brick != nullptr && isSet_(*brick, toPositionInBrick_(cell));
+}
+
+const std::vector<ElementId>& VoxelIndex::getElementIds(const Cell& cell) const
+{
+    static const std::vector<ElementId> empty;
+    const Brick* brick = bricks_.find(toBrickKey_(cell));
+    const std::size_t position = toPositionInBrick_(cell);
+    if (brick == nullptr || !isSet_(*brick, position)) {
+        return empty;
+    }
+    return brick->elementIds[rank_(*brick, position)];
+}
+
+std::vector<Cell> VoxelIndex::getOccupiedCells() const
+{
+    std::vector<Cell> res;
+    bricks_.forEach([&](const BrickKey& key, const Brick& brick) {
+        for (std::size_t position = 0; position < CELLS_PER_BRICK; position++) {
+            if (isSet_(brick, position)) {
+                res.push_back(Cell{
+                    key[0] * BRICK_SIZE + CellDir(position % BRICK_SIZE),
+                    key[1] * BRICK_SIZE + CellDir(position / BRICK_SIZE % BRICK_SIZE),
+                    key[2] * BRICK_SIZE + CellDir(position / (BRICK_SIZE * BRICK_SIZE))
+                });
+            }
+        }
+    });
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+std::map<Cell, ElementsView> VoxelIndex::buildCellElemMap(const Elements& elems) const
+{
+    std::map<Cell, ElementsView> res;
+    for (auto const& cell : getOccupiedCells()) {
+        auto const& ids = getElementIds(cell);
+        ElementsView view;
+        view.reserve(ids.size());
+        for (auto const& id : ids) {
+            view.push_back(&elems[id]);
+        }
+        res.emplace_hint(res.end(), cell, std::move(view));
+    }
+    return res;
+}
+
+VoxelIndex::BrickKey VoxelIndex::toBrickKey_(const Cell& cell)
+{
+    BrickKey res;
+    for (std::size_t d = 0; d < 3; d++) {
+        res[d] = cell(d) >= 0 ? cell(d) / BRICK_SIZE : (cell(d) + 1) / BRICK_SIZE - 1;
+    }
+    return res;
+}
+
+std::size_t VoxelIndex::toPositionInBrick_(const Cell& cell)
+{
+    const BrickKey key = toBrickKey_(cell);
+    std::size_t res = 0;
+    for (std::size_t d = 3; d-- > 0;) {
+        res = res * BRICK_SIZE + std::size_t(cell(d) - key[d] * BRICK_SIZE);
+    }
+    return res;
+}
+
+std::size_t VoxelIndex::rank_(const Brick& brick, std::size_t position)
+{
+    const std::size_t word = position / BITS_PER_WORD;
+    std::size_t res = 0;
+    for (std::size_t w = 0; w < word; w++) {
+        res += std::bitset<BITS_PER_WORD>(brick.occupancy[w]).count();
+    }
+    const std::uint64_t lowerBits = (std::uint64_t(1) << (position % BITS_PER_WORD)) - 1;
+    return res + std::bitset<BITS_PER_WORD>(brick.occupancy[word] & lowerBits).count();
+}
+
+bool VoxelIndex::isSet_(const Brick& brick, std::size_t position)
+{
+    return (brick.occupancy[position / BITS_PER_WORD] >> (position % BITS_PER_WORD)) & 1;
+}
+
+VoxelIndex::ElementCells VoxelIndex::buildElementCells_(const Element& e, const Coordinates& coords) const
+{
+    Coordinate centroid;
+    for (std::size_t i = 0; i < e.vertices.size(); i++) {
+        centroid += coords[e.vertices[i]] / double(e.vertices.size());
+    }
+
+    const std::set<Cell> touching = gT_.getTouchingCells(centroid);
+    return ElementCells(touching.begin(), touching.end());
+}
+
+void VoxelIndex::add_(ElementId id, const Cell& cell)
+{
+    Brick& brick = bricks_[toBrickKey_(cell)];
+    const std::size_t position = toPositionInBrick_(cell);
+    const std::size_t rank = rank_(brick, position);
+    if (!isSet_(brick, position)) {
+        brick.occupancy[position / BITS_PER_WORD] |= std::uint64_t(1) << (position % BITS_PER_WORD);
+        brick.elementIds.insert(brick.elementIds.begin() + rank, std::vector<ElementId>{ id });
+        return;
+    }
+    auto& ids = brick.elementIds[rank];
+    ids.insert(std::lower_bound(ids.begin(), ids.end(), id), id);
+}
+
+void VoxelIndex::remove_(ElementId id, const Cell& cell)
+{
+    Brick& brick = *bricks_.find(toBrickKey_(cell));
+    const std::size_t position = toPositionInBrick_(cell);
+    const std::size_t rank = rank_(brick, position);
+    auto& ids = brick.elementIds[rank];
+    ids.erase(std::lower_bound(ids.begin(), ids.end(), id));
+    if (ids.empty()) {
+        brick.occupancy[position / BITS_PER_WORD] &= ~(std::uint64_t(1) << (position % BITS_PER_WORD));
+        brick.elementIds.erase(brick.elementIds.begin() + rank);
+    }
+}
+
+}
+}
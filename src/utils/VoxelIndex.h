@@ -0,0 +1,71 @@
+#pragma once
+
+#include "types/Mesh.h"
+#include "Types.h"
+#include "GridTools.h"
+#include "FlatHashMap.h"
+
+#include <boost/container/small_vector.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace meshlib {
+namespace utils {
+
+// Sparse index of the cells which contain each element. An element is placed in
+// the cells touched by its centroid, as in GridTools::buildCellElemMap. Cells are
+// grouped in bricks of BRICK_SIZE^3 cells stored in a hash map, each with an
+// occupancy bitmask and the element ids of its occupied cells, so empty regions
+// of the grid take no memory. Element ids in each cell are kept sorted.
+// It is a local helper for algorithms which look up the elements around cells
+// while adding and removing elements, and does not follow coordinate moves.
+class VoxelIndex {
+public:
+    static constexpr CellDir BRICK_SIZE = 8;
+
+    VoxelIndex() = default;
+    VoxelIndex(const GridTools&, const Elements&, const Coordinates&);
+
+    // Adds an element with the next element id.
+    void insert(const Element&, const Coordinates&);
+    // Removes elements and renumbers the remaining ones in the same way as
+    // RedundancyCleaner::removeElements.
+    void erase(const IdSet& elementIds);
+
+    std::size_t elementsSize() const { return elementCells_.size(); }
+    bool isOccupied(const Cell&) const;
+    const std::vector<ElementId>& getElementIds(const Cell&) const;
+    std::vector<Cell> getOccupiedCells() const;
+
+    std::map<Cell, ElementsView> buildCellElemMap(const Elements&) const;
+
+private:
+    static constexpr std::size_t CELLS_PER_BRICK = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+    static constexpr std::size_t BITS_PER_WORD = 64;
+
+    typedef std::array<CellDir, 3> BrickKey;
+    typedef boost::container::small_vector<Cell, 2> ElementCells;
+
+    struct Brick {
+        std::array<std::uint64_t, CELLS_PER_BRICK / BITS_PER_WORD> occupancy{};
+        // Element ids of the occupied cells in order of their position in the brick.
+        std::vector<std::vector<ElementId>> elementIds;
+    };
+
+    GridTools gT_;
+    FlatHashMap<BrickKey, Brick, ArrayHash<CellDir, 3>> bricks_;
+    std::vector<ElementCells> elementCells_;
+
+    static BrickKey toBrickKey_(const Cell&);
+    static std::size_t toPositionInBrick_(const Cell&);
+    static std::size_t rank_(const Brick&, std::size_t position);
+    static bool isSet_(const Brick&, std::size_t position);
+
+    ElementCells buildElementCells_(const Element&, const Coordinates&) const;
+    void add_(ElementId, const Cell&);
+    void remove_(ElementId, const Cell&);
+};
+
+}
+}
@@ -50,4 +50,40 @@ TEST_F(LauncherTest, launches_cone_case)
     int exitCode;
     EXPECT_NO_THROW(exitCode = meshlib::app::launcher(ac, av));
     EXPECT_EQ(exitCode, EXIT_SUCCESS);
-}
\ No newline at end of file
+}
+
+TEST_F(LauncherTest, launches_alhambra_case_with_vtp_output)
+{
+    int ac = 7;
+    const char* av[] = { NULL, 
+        "-i", "testData/cases/alhambra/alhambra.tessellator.json",
+        "-f", "vtp", "-c", "lz4"};
+    int exitCode;
+    EXPECT_NO_THROW(exitCode = meshlib::app::launcher(ac, av));
+    EXPECT_EQ(exitCode, EXIT_SUCCESS);
+}
+
+TEST_F(LauncherTest, serves_jobs)
+{
+    std::stringstream jobs;
+    jobs << R"({"id": 1, "input": "testData/cases/alhambra/alhambra.tessellator.json"})" << std::endl
+         << std::endl
+         << R"({"id": 2, "input": "testData/cases/alhambra/alhambra.tessellator.json", "format": "vtu"})" << std::endl
+         << R"({"id": 3, "input": "testData/cases/nonExistent.tessellator.json"})" << std::endl;
+    std::stringstream responses;
+
+    EXPECT_EQ(meshlib::app::serve(jobs, responses), EXIT_SUCCESS);
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(responses, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 3);
+    EXPECT_NE(lines[0].find(R"("status":"ok")"), std::string::npos);
+    EXPECT_NE(lines[0].find("alhambra.tessellator.str.vtk"), std::string::npos);
+    EXPECT_NE(lines[0].find(R"("meshing")"), std::string::npos);
+    EXPECT_NE(lines[0].find(R"("meshing.slicing")"), std::string::npos);
+    EXPECT_NE(lines[1].find("alhambra.tessellator.str.vtu"), std::string::npos);
+    EXPECT_NE(lines[2].find(R"("status":"error")"), std::string::npos);
+    EXPECT_NE(lines[2].find(R"("id":3)"), std::string::npos);
+}
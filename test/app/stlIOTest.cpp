@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "app/stlIO.h"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace meshlib;
+using namespace meshlib::stlIO;
+
+namespace {
+
+// Writes the contents into a file of the temporary directory which is
+// removed when going out of scope.
+class TemporaryFile {
+public:
+    TemporaryFile(const std::string& name, const std::string& contents) :
+        path_{ std::filesystem::temp_directory_path() / name }
+    {
+        std::ofstream out(path_);
+        out << contents;
+    }
+    ~TemporaryFile()
+    {
+        std::filesystem::remove(path_);
+    }
+
+    std::string getFilename() const { return path_.string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+}
+
+class STLIOTest : public ::testing::Test
+{
+};
+
+TEST_F(STLIOTest, readBinarySTL)
+{
+    auto m{ readSTL("testData/cases/alhambra/alhambra.stl") };
+
+    EXPECT_EQ(m.coordinates.size(), 584);
+    EXPECT_EQ(m.groups.size(), 1);  
+    EXPECT_EQ(m.countElems(), 1284);
+}
+
+TEST_F(STLIOTest, readASCIISTL)
+{
+    TemporaryFile file{ "tessellator_stl_io_test_ascii.stl",
+        std::string("solid square\n")
+            + "  facet normal 0 0 1\n"
+            + "    outer loop\n"
+            + "      vertex 0.0 0.0 0.0\n"
+            + "      vertex 1.0 0.0 0.0\n"
+            + "      vertex 1.0 1.0 0.0\n"
+            + "    endloop\n"
+            + "  endfacet\n"
+            + "  facet normal 0 0 1\n"
+            + "    outer loop\n"
+            + "      vertex 1.0 1.0 0.0\n"
+            + "      vertex 0.0 1.0 0.0\n"
+            + "      vertex 0e+00 -0.0 0.0\n"
+            + "    endloop\n"
+            + "  endfacet\n"
+            + "endsolid square\n"
+    };
+
+    auto m{ readSTL(file.getFilename()) };
+
+    EXPECT_EQ(m.coordinates, Coordinates({
+        Coordinate({0.0, 0.0, 0.0}),
+        Coordinate({1.0, 0.0, 0.0}),
+        Coordinate({1.0, 1.0, 0.0}),
+        Coordinate({0.0, 1.0, 0.0}),
+    }));
+    ASSERT_EQ(m.groups.size(), 1);
+    EXPECT_EQ(m.groups[0].elements, Elements({
+        Element({0, 1, 2}),
+        Element({2, 3, 0}),
+    }));
+}
+
+TEST_F(STLIOTest, degenerateTrianglesAreDiscarded)
+{
+    TemporaryFile file{ "tessellator_stl_io_test_degenerate.stl",
+        std::string("solid degenerate\n")
+            + "  facet normal 0 0 1\n"
+            + "    outer loop\n"
+            + "      vertex 0.0 0.0 0.0\n"
+            + "      vertex 1.0 0.0 0.0\n"
+            + "      vertex 0.0 0.0 0.0\n"
+            + "    endloop\n"
+            + "  endfacet\n"
+            + "endsolid degenerate\n"
+    };
+
+    auto m{ readSTL(file.getFilename()) };
+
+    EXPECT_EQ(m.coordinates.size(), 2);
+    EXPECT_EQ(m.countElems(), 0);
+}
+
+TEST_F(STLIOTest, throwsWhenFileDoesNotExist)
+{
+    EXPECT_THROW(readSTL("testData/nonExistent.stl"), std::runtime_error);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "app/vtkIO.h"
+#include "app/stlIO.h"
 #include "utils/GridTools.h"
 
 using namespace meshlib::vtkIO;
@@ -20,6 +21,17 @@ TEST_F(VTKIOTest, readMeshFromSTL)
     EXPECT_EQ(m.countElems(), 1284);
 }
 
+TEST_F(VTKIOTest, nativeSTLReaderGivesSameMeshAsVTK)
+{
+    std::string fn{"testData/cases/alhambra/alhambra.stl"};
+
+    auto native{ meshlib::stlIO::readSTL(fn) };
+    auto vtk{ readInputMeshWithVTK(fn) };
+
+    EXPECT_EQ(vtk.coordinates, native.coordinates);
+    EXPECT_EQ(vtk.groups, native.groups);
+}
+
 TEST_F(VTKIOTest, exportAndReadMeshFromVTU)
 {
     auto mSTL{ readInputMesh("testData/cases/alhambra/alhambra.stl") };
@@ -56,4 +68,67 @@ TEST_F(VTKIOTest, exportGridToVTU)
     auto exported{ readInputMesh(fn) };
 
     EXPECT_EQ(121+121+21, exported.countElems());
-}
\ No newline at end of file
+}
+
+TEST_F(VTKIOTest, exportAndReadMeshWithGroupsAndElementTypes)
+{
+    meshlib::Mesh m;
+    m.coordinates = {
+        meshlib::Coordinate({0.0, 0.0, 0.0}),
+        meshlib::Coordinate({1.0, 0.0, 0.0}),
+        meshlib::Coordinate({1.0, 1.0, 0.0}),
+        meshlib::Coordinate({0.0, 1.0, 0.0}),
+    };
+    m.groups.resize(2);
+    m.groups[0].elements = {
+        meshlib::Element({0, 1, 2, 3}, meshlib::Element::Type::Surface),
+        meshlib::Element({0, 1}, meshlib::Element::Type::Line),
+    };
+    m.groups[1].elements = {
+        meshlib::Element({0, 1, 2}, meshlib::Element::Type::Surface),
+        meshlib::Element({3}, meshlib::Element::Type::Node),
+    };
+
+    exportMeshToVTU("tmp_exported_element_types.vtu", m);
+    auto r{ readInputMesh("tmp_exported_element_types.vtu") };
+
+    EXPECT_EQ(m.coordinates, r.coordinates);
+    EXPECT_EQ(m.groups, r.groups);
+}
+
+TEST_F(VTKIOTest, exportAndReadMeshWithCompressions)
+{
+    auto m{ readInputMesh("testData/cases/alhambra/alhambra.stl") };
+
+    for (auto compression: {Compression::None, Compression::ZLib, Compression::LZ4}) {
+        exportMeshToVTU("tmp_exported_alhambra_compressed.vtu", m, compression);
+        auto r{ readInputMesh("tmp_exported_alhambra_compressed.vtu") };
+        EXPECT_EQ(m.coordinates, r.coordinates);
+        EXPECT_EQ(m.groups, r.groups);
+    }
+}
+
+TEST_F(VTKIOTest, exportAndReadMeshFromVTP)
+{
+    meshlib::Mesh m;
+    m.coordinates = {
+        meshlib::Coordinate({0.0, 0.0, 0.0}),
+        meshlib::Coordinate({1.0, 0.0, 0.0}),
+        meshlib::Coordinate({1.0, 1.0, 0.0}),
+        meshlib::Coordinate({0.0, 1.0, 0.0}),
+    };
+    m.groups.resize(2);
+    m.groups[0].elements = {
+        meshlib::Element({3}, meshlib::Element::Type::Node),
+        meshlib::Element({0, 1}, meshlib::Element::Type::Line),
+    };
+    m.groups[1].elements = {
+        meshlib::Element({0, 1, 2, 3}, meshlib::Element::Type::Surface),
+    };
+
+    exportMeshToVTP("tmp_exported_mesh.vtp", m);
+    auto r{ readInputMesh("tmp_exported_mesh.vtp") };
+
+    EXPECT_EQ(m.coordinates, r.coordinates);
+    EXPECT_EQ(m.groups, r.groups);
+}
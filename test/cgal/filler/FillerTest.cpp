@@ -5,6 +5,9 @@
 #include "filler/Filler.h"
 #include "core/Slicer.h"
 #include "meshers/OffgridMesher.h"
+#include "utils/RedundancyCleaner.h"
+
+#include <filesystem>
 
 namespace meshlib::cgal::filler {
 
@@ -893,4 +896,108 @@ TEST_F(FillerTest, fillingDetection_cube)
     }
 }
 
+TEST_F(FillerTest, partial_face_fillings_in_bulk_are_same_as_face_by_face)
+{
+    Filler f{ Slicer{ buildTetSurfaceMesh(0.25) }.getMesh() };
+
+    auto fillings{ f.getPartialFaceFillings() };
+    ASSERT_FALSE(fillings.empty());
+    for (const auto& [c, ff] : fillings) {
+        EXPECT_TRUE(f.getFillingState(c).partial());
+        auto expected{ f.getFaceFilling(c) };
+        EXPECT_EQ(countPWHs(expected), countPWHs(ff));
+        EXPECT_EQ(expected.lins, ff.lins);
+        EXPECT_NEAR(expected.allSurfaces().area(), ff.allSurfaces().area(), 1e-12);
+    }
+
+    auto sliceFillings{ f.getPartialFaceFillings(Z, 1) };
+    for (const auto& [idx, ff] : sliceFillings) {
+        EXPECT_EQ(countPWHs(f.getFaceFilling({ Cell({ idx[0], idx[1], 1 }), Z })), countPWHs(ff));
+    }
+}
+
+TEST_F(FillerTest, dense_filling_states_are_same_as_queried_ones)
+{
+    auto m{ buildTetSurfaceMesh(0.25) };
+    Filler f{ Slicer{ m }.getMesh() };
+
+    auto dense{ f.getDenseFillingStates() };
+    auto sameState = [](const FillingState& a, const FillingState& b) {
+        return a.type == b.type && (!a.full() || a.getPriority() == b.getPriority());
+    };
+    // Edges are full when covered by a single segment of a single priority.
+    auto buildEdgeState = [](const EdgeFilling& ef, const CellIndex& c) -> FillingState {
+        if (ef.lins.empty()) {
+            return { FillingType::Empty };
+        }
+        const Segment1 edge{ Point1(c.getSliceNumber()), Point1(c.getSliceNumber() + 1) };
+        const auto& [pr, segs] { *ef.lins.begin() };
+        if (ef.lins.size() == 1 && segs.size() == 1 && segs.front() == edge) {
+            return { pr };
+        }
+        return { FillingType::Partial };
+    };
+    std::size_t fullEdges{ 0 };
+    std::size_t partialEdges{ 0 };
+    for (const auto& x : { X, Y, Z }) {
+        for (int i{ 0 }; i < (int)m.grid[X].size(); ++i) {
+            for (int j{ 0 }; j < (int)m.grid[Y].size(); ++j) {
+                for (int k{ 0 }; k < (int)m.grid[Z].size(); ++k) {
+                    const CellIndex c{ Cell({ i, j, k }), x };
+                    EXPECT_TRUE(sameState(f.getFillingState(c), dense.getFaceFillingState(c)));
+
+                    const auto edgeState{ buildEdgeState(f.getEdgeFilling(c), c) };
+                    EXPECT_TRUE(sameState(edgeState, dense.getEdgeFillingState(c)));
+                    fullEdges += edgeState.full() ? 1 : 0;
+                    partialEdges += edgeState.partial() ? 1 : 0;
+                }
+            }
+        }
+    }
+    EXPECT_LT(0, fullEdges);
+    EXPECT_LT(0, partialEdges);
+
+    auto fileName{ std::filesystem::temp_directory_path() / "tessellator_filling_states_test.fill" };
+    writeFillingStates(fileName, dense);
+    EXPECT_EQ(dense, readFillingStates(fileName));
+    std::filesystem::remove(fileName);
+}
+
+TEST_F(FillerTest, lazy_slices_give_same_results_as_eager_ones)
+{
+    auto m{ Slicer{ buildTetSurfaceMesh(0.25) }.getMesh() };
+    Filler eager{ m };
+
+    FillerOptions opts;
+    opts.lazySlices = true;
+    opts.maxSlicesMemoryInBytes = 1;
+    Filler lazy{ m, Mesh(), std::vector<Priority>(), opts };
+
+    EXPECT_EQ(eager.getMeshFilling(), lazy.getMeshFilling());
+    EXPECT_EQ(eager.getDenseFillingStates(), lazy.getDenseFillingStates());
+    for (int i{ 0 }; i < (int)m.grid[Z].size(); ++i) {
+        const CellIndex c{ Cell({ 1, 1, i }), Z };
+        EXPECT_EQ(eager.getFaceFilling(c), lazy.getFaceFilling(c));
+    }
+}
+
+TEST_F(FillerTest, fused_mesh_filling_has_no_repeated_coordinates)
+{
+    auto m{ Slicer{ buildCubeSurfaceMesh(0.25) }.getMesh() };
+    auto filling{ Filler{ m }.getMeshFilling() };
+
+    FillerOptions opts;
+    opts.fuseMeshFillingCoordinates = true;
+    auto fused{ Filler{ m, Mesh(), std::vector<Priority>(), opts }.getMeshFilling() };
+
+    EXPECT_EQ(filling.countElems(), fused.countElems());
+    EXPECT_LT(fused.coordinates.size(), filling.coordinates.size());
+    std::set<Coordinate> positions(fused.coordinates.begin(), fused.coordinates.end());
+    EXPECT_EQ(positions.size(), fused.coordinates.size());
+
+    utils::RedundancyCleaner::fuseCoords(filling);
+    utils::RedundancyCleaner::cleanCoords(filling);
+    EXPECT_EQ(filling, fused);
+}
+
 }
\ No newline at end of file
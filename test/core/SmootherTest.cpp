@@ -5,6 +5,7 @@
 #include "utils/Tools.h"
 #include "utils/Geometry.h"
 #include "utils/MeshTools.h"
+#include "utils/Parallel.h"
 #include "core/Slicer.h"
 #include "app/vtkIO.h"
 
@@ -146,4 +147,27 @@ TEST_F(SmootherTest, preserves_topological_closedness_for_sphere)
 	// vtkIO::exportMeshToVTU("testData/cases/sphere/sphere.contour.vtk", contourMesh);
 }
 
+
+TEST_F(SmootherTest, same_result_with_serial_and_threads_backends)
+{
+    auto m = vtkIO::readInputMesh("testData/cases/alhambra/alhambra.stl");
+    m.grid[X] = utils::GridTools::linspace(-60.0, 60.0, 61); 
+    m.grid[Y] = utils::GridTools::linspace(-60.0, 60.0, 61); 
+    m.grid[Z] = utils::GridTools::linspace(-1.872734, 11.236404, 8);
+    auto slicedMesh = Slicer{m}.getMesh();
+
+    SmootherOptions smootherOpts;
+    smootherOpts.featureDetectionAngle = 30;
+    smootherOpts.contourAlignmentAngle = 0;
+    auto smoothWith = [&](ExecutionBackend backend) {
+        ExecutionOptions execution;
+        execution.backend = backend;
+        execution.numberOfThreads = 4;
+        const ScopedExecution scoped(execution);
+        return Smoother{slicedMesh, smootherOpts}.getMesh();
+    };
+
+    EXPECT_EQ(smoothWith(ExecutionBackend::Serial), smoothWith(ExecutionBackend::Threads));
+}
+
 }
\ No newline at end of file
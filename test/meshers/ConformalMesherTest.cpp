@@ -7,6 +7,8 @@
 #include "app/vtkIO.h"
 #include "utils/MeshTools.h"
 
+#include <filesystem>
+
 namespace meshlib::meshers {
 using namespace meshFixtures;
 using namespace utils::meshTools;
@@ -421,6 +423,30 @@ TEST_F(ConformalMesherTest, thinCylinder)
     EXPECT_NE(0, mesh.countElems());
 }
 
+TEST_F(ConformalMesherTest, results_are_stored_in_cache_once)
+{
+    ConformalMesherOptions opts;
+    opts.cache.directory = std::filesystem::temp_directory_path() / "tessellator_conformal_cache_test";
+    std::filesystem::remove_all(opts.cache.directory);
+    auto countEntries = [&]() {
+        return std::distance(
+            std::filesystem::directory_iterator(opts.cache.directory),
+            std::filesystem::directory_iterator());
+    };
+
+    ConformalMesher mesher{ buildPlane45Mesh(0.25), opts };
+    auto computed{ mesher.mesh() };
+    EXPECT_EQ(1, countEntries());
+
+    for (const auto& entry : std::filesystem::directory_iterator(opts.cache.directory)) {
+        std::filesystem::remove(entry.path());
+    }
+    EXPECT_EQ(computed, mesher.mesh());
+    EXPECT_EQ(0, countEntries());
+
+    std::filesystem::remove_all(opts.cache.directory);
+}
+
 // TEST_F(ConformalMesherTest, plane45_size05_grid_adapted) 
 // {
 //     ConformalMesher mesher(buildPlane45Mesh(0.5));
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "MeshFixtures.h"
+
+#include "meshers/MeshCache.h"
+#include "utils/BinaryMeshIO.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace meshlib::meshers {
+using namespace meshFixtures;
+
+class MeshCacheTest : public ::testing::Test {
+public:
+    static CacheOptions buildOptions(const std::string& name)
+    {
+        CacheOptions res;
+        res.directory = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(res.directory);
+        return res;
+    }
+
+    static std::size_t countEntries(const CacheOptions& opts)
+    {
+        return std::distance(
+            std::filesystem::directory_iterator(opts.directory),
+            std::filesystem::directory_iterator());
+    }
+};
+
+TEST_F(MeshCacheTest, keys_depend_on_all_inputs)
+{
+    const Mesh m = buildTri45Mesh(0.5);
+    Mesh moved = m;
+    moved.coordinates[0](0) += 1e-12;
+    Mesh otherGrid = m;
+    otherGrid.grid[2].back() += 1.0;
+
+    const std::string key = CacheKey("mesher").add(m).add(4).toString();
+    EXPECT_EQ(32, key.size());
+    EXPECT_EQ(key, CacheKey("mesher").add(m).add(4).toString());
+    EXPECT_NE(key, CacheKey("other").add(m).add(4).toString());
+    EXPECT_NE(key, CacheKey("mesher").add(m).add(3).toString());
+    EXPECT_NE(key, CacheKey("mesher").add(moved).add(4).toString());
+    EXPECT_NE(key, CacheKey("mesher").add(otherGrid).add(4).toString());
+}
+
+TEST_F(MeshCacheTest, stores_and_loads_meshes)
+{
+    const CacheOptions opts = buildOptions("tessellator_mesh_cache_test");
+    const MeshCache cache(opts);
+    const Mesh m = buildTri45Mesh(0.5);
+    const CacheKey key = CacheKey("mesher").add(m);
+
+    EXPECT_FALSE(cache.load(key).has_value());
+    cache.store(key, m);
+    auto loaded = cache.load(key);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(m, *loaded);
+
+    // Corrupted entries are discarded.
+    std::ofstream(opts.directory / (key.toString() + ".mesh"), std::ios::binary) << "garbage";
+    EXPECT_FALSE(cache.load(key).has_value());
+    EXPECT_EQ(0, countEntries(opts));
+
+    std::filesystem::remove_all(opts.directory);
+}
+
+TEST_F(MeshCacheTest, evicts_least_recently_used)
+{
+    CacheOptions opts = buildOptions("tessellator_mesh_cache_eviction_test");
+    const Mesh m = buildTri45Mesh(0.5);
+    std::stringstream ss;
+    utils::binaryMeshIO::writeMesh(ss, m);
+    opts.maxSizeInBytes = 2 * ss.str().size();
+    const MeshCache cache(opts);
+
+    const CacheKey a = CacheKey("a").add(m);
+    const CacheKey b = CacheKey("b").add(m);
+    const CacheKey c = CacheKey("c").add(m);
+    auto setLastUse = [&](const CacheKey& key, int secondsAgo) {
+        std::filesystem::last_write_time(
+            opts.directory / (key.toString() + ".mesh"),
+            std::filesystem::file_time_type::clock::now() - std::chrono::seconds(secondsAgo));
+    };
+
+    cache.store(a, m);
+    setLastUse(a, 20);
+    cache.store(b, m);
+    setLastUse(b, 30);
+    EXPECT_TRUE(cache.load(a).has_value());
+
+    cache.store(c, m);
+
+    EXPECT_EQ(2, countEntries(opts));
+    EXPECT_TRUE(cache.load(a).has_value());
+    EXPECT_FALSE(cache.load(b).has_value());
+    EXPECT_TRUE(cache.load(c).has_value());
+
+    std::filesystem::remove_all(opts.directory);
+}
+
+}
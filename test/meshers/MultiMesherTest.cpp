@@ -0,0 +1,63 @@
+#include "gtest/gtest.h"
+#include "MeshFixtures.h"
+
+#include "meshers/MultiMesher.h"
+#include "meshers/StructuredMesher.h"
+#include "meshers/OffgridMesher.h"
+#include "meshers/ConformalMesher.h"
+
+namespace meshlib::meshers {
+using namespace meshFixtures;
+
+class MultiMesherTest : public ::testing::Test {
+public:
+    static void expectSameAsSeparateMeshers(const Mesh& in, const MultiMesherOptions& opts)
+    {
+        const auto res{ meshAll(in, opts) };
+
+        ASSERT_EQ(opts.structured, res.structured.has_value());
+        if (opts.structured) {
+            EXPECT_EQ(StructuredMesher(in, opts.decimalPlacesInCollapser, opts.validation).mesh(), *res.structured);
+        }
+        ASSERT_EQ(opts.offgrid.has_value(), res.offgrid.has_value());
+        if (opts.offgrid) {
+            EXPECT_EQ(OffgridMesher(in, *opts.offgrid).mesh(), *res.offgrid);
+        }
+        ASSERT_EQ(opts.conformal.has_value(), res.conformal.has_value());
+        if (opts.conformal) {
+            EXPECT_EQ(ConformalMesher(in, *opts.conformal).mesh(), *res.conformal);
+        }
+    }
+};
+
+TEST_F(MultiMesherTest, shared_slicing_gives_same_results_as_separate_meshers)
+{
+    MultiMesherOptions opts;
+    opts.offgrid = OffgridMesherOptions();
+    opts.conformal = ConformalMesherOptions();
+    opts.execution.backend = utils::ExecutionBackend::Threads;
+    opts.execution.numberOfThreads = 3;
+    
+    expectSameAsSeparateMeshers(buildPlane45Mesh(0.25), opts);
+
+    opts.offgrid->reorderSpatially = true;
+    opts.conformal->reorderSpatially = true;
+    expectSameAsSeparateMeshers(buildPlane45Mesh(0.25), opts);
+
+    opts.offgrid->reorderSpatially = false;
+    opts.offgrid->decimalPlacesInCollapser = 2;
+    opts.offgrid->snap = false;
+    expectSameAsSeparateMeshers(buildPlane45Mesh(0.25), opts);
+}
+
+TEST_F(MultiMesherTest, offgrid_volume_groups_are_meshed_separately)
+{
+    MultiMesherOptions opts;
+    opts.offgrid = OffgridMesherOptions();
+    opts.offgrid->volumeGroups = { 0 };
+    opts.conformal = ConformalMesherOptions();
+
+    expectSameAsSeparateMeshers(buildCubeSurfaceMesh(1.0), opts);
+}
+
+}
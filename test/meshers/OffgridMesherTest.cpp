@@ -3,8 +3,11 @@
 #include "MeshTools.h"
 
 #include "meshers/OffgridMesher.h"
+#include "meshers/IncrementalMesher.h"
 #include "utils/Geometry.h"
 
+#include <filesystem>
+
 namespace meshlib::meshers {
 using namespace meshFixtures;
 using namespace utils::meshTools;
@@ -459,4 +462,120 @@ TEST_F(OffgridMesherTest, meshed_with_holes_issue)
     EXPECT_LT(374, countMeshElementsIf(out, isTriangle));
 }
 
-}
\ No newline at end of file
+
+TEST_F(OffgridMesherTest, reorder_spatially_keeps_same_mesh)
+{
+    auto opts{ buildSnappedOptions() };
+    auto reordered{ opts };
+    reordered.reorderSpatially = true;
+
+    auto r{ OffgridMesher{ buildPlane45Mesh(0.25), opts }.mesh() };
+    auto p{ OffgridMesher{ buildPlane45Mesh(0.25), reordered }.mesh() };
+
+    auto buildTriangleSet = [](const Mesh& m) {
+        std::set<std::set<Coordinate>> res;
+        for (auto const& e : m.groups[0].elements) {
+            std::set<Coordinate> tri;
+            for (auto const& vId : e.vertices) {
+                tri.insert(m.coordinates[vId]);
+            }
+            res.insert(tri);
+        }
+        return res;
+    };
+
+    EXPECT_EQ(r.countElems(), p.countElems());
+    EXPECT_EQ(buildTriangleSet(r), buildTriangleSet(p));
+}
+
+TEST_F(OffgridMesherTest, cached_results_are_reused)
+{
+    auto opts{ buildSnappedOptions() };
+    opts.cache.directory = std::filesystem::temp_directory_path() / "tessellator_offgrid_cache_test";
+    std::filesystem::remove_all(opts.cache.directory);
+
+    auto computed{ OffgridMesher{ buildPlane45Mesh(0.25), opts }.mesh() };
+    EXPECT_EQ(1, std::distance(
+        std::filesystem::directory_iterator(opts.cache.directory), 
+        std::filesystem::directory_iterator()));
+
+    auto loaded{ OffgridMesher{ buildPlane45Mesh(0.25), opts }.mesh() };
+    EXPECT_EQ(computed, loaded);
+
+    auto otherOpts{ opts };
+    otherOpts.snap = false;
+    OffgridMesher{ buildPlane45Mesh(0.25), otherOpts }.mesh();
+    EXPECT_EQ(2, std::distance(
+        std::filesystem::directory_iterator(opts.cache.directory), 
+        std::filesystem::directory_iterator()));
+
+    std::filesystem::remove_all(opts.cache.directory);
+}
+
+TEST_F(OffgridMesherTest, resumes_from_stage_checkpoints)
+{
+    auto opts{ buildSnappedOptions() };
+    opts.checkpoints.directory = std::filesystem::temp_directory_path() / "tessellator_offgrid_checkpoints_test";
+    std::filesystem::remove_all(opts.checkpoints.directory);
+
+    auto computed{ OffgridMesher{ buildPlane45Mesh(0.25), opts }.mesh() };
+    EXPECT_TRUE(std::filesystem::exists(opts.checkpoints.directory / "offgrid.surface.smoothing.checkpoint"));
+
+    for (auto const& stage : { "collapsing", "smoothing", "snapping" }) {
+        auto resumed{ opts };
+        resumed.checkpoints.resumeFrom = stage;
+        EXPECT_EQ(computed, OffgridMesher(buildPlane45Mesh(0.25), resumed).mesh());
+    }
+
+    auto otherOpts{ opts };
+    otherOpts.snapperOptions.edgePoints = 1;
+    otherOpts.checkpoints.resumeFrom = "snapping";
+    EXPECT_THROW(OffgridMesher(buildPlane45Mesh(0.25), otherOpts), std::runtime_error);
+
+    auto unknownStage{ opts };
+    unknownStage.checkpoints.resumeFrom = "staircasing";
+    EXPECT_THROW(OffgridMesher(buildPlane45Mesh(0.25), unknownStage), std::runtime_error);
+
+    std::filesystem::remove_all(opts.checkpoints.directory);
+}
+
+TEST_F(OffgridMesherTest, remeshes_only_changed_groups)
+{
+    auto buildTriangleSet = [](const Mesh& m, GroupId g) {
+        std::set<std::set<Coordinate>> res;
+        for (auto const& e : m.groups[g].elements) {
+            std::set<Coordinate> tri;
+            for (auto const& vId : e.vertices) {
+                tri.insert(m.coordinates[vId]);
+            }
+            res.insert(tri);
+        }
+        return res;
+    };
+
+    auto opts{ buildSnappedOptions() };
+    Mesh m{ buildTwoSquaresTwoGroupsXYMesh(0.25) };
+
+    auto first{ meshIncrementally<OffgridMesher>(m, opts) };
+    auto full{ OffgridMesher(m, opts).mesh() };
+    ASSERT_EQ(2, first.mesh.groups.size());
+    EXPECT_FALSE(first.mesh.groups[1].elements.empty());
+    for (GroupId g = 0; g < 2; g++) {
+        EXPECT_EQ(buildTriangleSet(full, g), buildTriangleSet(first.mesh, g));
+    }
+
+    // Group 0 is unchanged, so its previous mesh is used even if it is not the real one.
+    auto previous{ first };
+    previous.groupMeshes[0].groups[0].elements.clear();
+    m.coordinates[7] = Coordinate({ 0.9, 0.9, 0.0 });
+
+    auto second{ meshIncrementally<OffgridMesher>(m, opts, previous) };
+    EXPECT_EQ(first.groupKeys[0], second.groupKeys[0]);
+    EXPECT_NE(first.groupKeys[1], second.groupKeys[1]);
+    EXPECT_TRUE(second.mesh.groups[0].elements.empty());
+    EXPECT_EQ(
+        buildTriangleSet(OffgridMesher(m, opts).mesh(), 1), 
+        buildTriangleSet(second.mesh, 1));
+}
+
+}
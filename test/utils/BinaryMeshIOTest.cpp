@@ -0,0 +1,27 @@
+#include "gtest/gtest.h"
+#include "MeshFixtures.h"
+
+#include "utils/BinaryMeshIO.h"
+
+#include <sstream>
+
+namespace meshlib::utils {
+
+using namespace meshFixtures;
+
+class BinaryMeshIOTest : public ::testing::Test {};
+
+TEST_F(BinaryMeshIOTest, mesh_round_trip)
+{
+    Mesh m = buildTetAndTriMesh(0.5);
+    m.groups.push_back(Group());
+
+    std::stringstream ss;
+    binaryMeshIO::writeMesh(ss, m);
+    EXPECT_EQ(m, binaryMeshIO::readMesh(ss));
+
+    std::stringstream truncated(ss.str().substr(0, ss.str().size() - 1));
+    EXPECT_THROW(binaryMeshIO::readMesh(truncated), std::runtime_error);
+}
+
+}
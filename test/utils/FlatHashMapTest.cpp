@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+
+#include "utils/FlatHashMap.h"
+#include "utils/Types.h"
+
+namespace meshlib::utils {
+
+class FlatHashMapTest : public ::testing::Test {};
+
+TEST_F(FlatHashMapTest, emplace_and_find)
+{
+	FlatHashMap<CoordinateId, ElementId> map;
+	
+	const std::size_t n = 1000;
+	for (std::size_t i = 0; i < n; i++) {
+		auto [value, inserted] = map.emplace(3 * i, i);
+		EXPECT_TRUE(inserted);
+		EXPECT_EQ(i, *value);
+	}
+	EXPECT_EQ(n, map.size());
+
+	for (std::size_t i = 0; i < n; i++) {
+		auto [value, inserted] = map.emplace(3 * i, 0);
+		EXPECT_FALSE(inserted);
+		EXPECT_EQ(i, *value);
+		ASSERT_NE(nullptr, map.find(3 * i));
+		EXPECT_EQ(i, *map.find(3 * i));
+		EXPECT_EQ(nullptr, map.find(3 * i + 1));
+	}
+	EXPECT_EQ(n, map.size());
+}
+
+TEST_F(FlatHashMapTest, array_keys)
+{
+	FlatHashSet<TriIds, ArrayHash<CoordinateId, 3>> set;
+
+	EXPECT_TRUE(set.insert({ 0, 1, 2 }));
+	EXPECT_TRUE(set.insert({ 0, 2, 1 }));
+	EXPECT_FALSE(set.insert({ 0, 1, 2 }));
+	
+	EXPECT_EQ(2, set.size());
+	EXPECT_EQ(1, set.count({ 0, 2, 1 }));
+	EXPECT_EQ(0, set.count({ 1, 2, 0 }));
+}
+
+}
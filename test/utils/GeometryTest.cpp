@@ -315,6 +315,49 @@ TEST_F(GeometryTest, disjointSets_topological_orientation)
 
 }
 
+TEST_F(GeometryTest, disjointSets_are_ordered_by_first_element)
+{
+	Coordinates cs = {
+		Coordinate({0.0, 0.0, 0.0}),
+		Coordinate({1.0, 0.0, 0.0}),
+		Coordinate({0.0, 1.0, 0.0}),
+		Coordinate({0.0, 0.0, 1.0}),
+		Coordinate({1.0, 1.0, 0.0})
+	};
+	Elements es = {
+		Element({0, 1, 2}, Element::Type::Surface),
+		Element({1, 0, 3}, Element::Type::Surface),
+		Element({1, 4, 2}, Element::Type::Surface)
+	};
+
+	auto ds = Geometry::buildDisjointSmoothSets(getView(es), cs, 80.0);
+	ASSERT_EQ(2, ds.size());
+	EXPECT_EQ(ElementsView({ &es[0], &es[2] }), ds[0]);
+	EXPECT_EQ(ElementsView({ &es[1] }), ds[1]);
+}
+
+TEST_F(GeometryTest, disjointSets_of_lines)
+{
+	Coordinates cs = {
+		Coordinate({0.0, 0.0, 0.0}),
+		Coordinate({1.0, 0.0, 0.0}),
+		Coordinate({2.0, 0.0, 0.0}),
+		Coordinate({2.0, 1.0, 0.0})
+	};
+	Elements es = {
+		Element({2, 3}, Element::Type::Line),
+		Element({0, 1}, Element::Type::Line),
+		Element({1, 2}, Element::Type::Line)
+	};
+
+	auto ds = Geometry::buildDisjointSmoothSets(getView(es), cs, 45.0);
+	ASSERT_EQ(2, ds.size());
+	EXPECT_EQ(ElementsView({ &es[0] }), ds[0]);
+	EXPECT_EQ(ElementsView({ &es[1], &es[2] }), ds[1]);
+
+	EXPECT_EQ(1, Geometry::buildDisjointSmoothSets(getView(es), cs, 100.0).size());
+}
+
 TEST_F(GeometryTest, areAdjacent_for_tris) 
 {
 	// 0 -> 1 <-  3 
@@ -379,4 +422,44 @@ TEST_F(GeometryTest, convertElementToLinV)
 	}
 }
 
+
+TEST_F(GeometryTest, batch_areas_normals_and_degeneracy)
+{
+	Coordinates cs;
+	for (std::size_t i = 0; i < 30; i++) {
+		const double t = double(i);
+		cs.push_back(Coordinate({ std::sin(t), std::cos(2.0 * t), 0.1 * t }));
+	}
+	cs.push_back(cs[0] + (cs[1] - cs[0]) * 0.5);
+
+	Elements es;
+	for (CoordinateId i = 0; i + 2 < 30; i++) {
+		es.push_back(Element({ i, i + 1, i + 2 }, Element::Type::Surface));
+	}
+	es.push_back(Element({ 0, 30, 1 }, Element::Type::Surface));
+	es.push_back(Element({ 0, 1 }, Element::Type::Line));
+	es.push_back(Element({ 2 }, Element::Type::Node));
+
+	auto areas = Geometry::areas(es, cs);
+	auto normals = Geometry::normals(es, cs);
+	auto degenerate = Geometry::areDegenerate(es, cs);
+
+	ASSERT_EQ(es.size(), areas.size());
+	ASSERT_EQ(es.size(), normals.size());
+	ASSERT_EQ(es.size(), degenerate.size());
+	for (std::size_t e = 0; e < es.size(); e++) {
+		if (!es[e].isTriangle()) {
+			EXPECT_EQ(0.0, areas[e]);
+			EXPECT_EQ(VecD(0.0), normals[e]);
+			EXPECT_FALSE(degenerate[e]);
+			continue;
+		}
+		const TriV tri = Geometry::asTriV(es[e], cs);
+		EXPECT_EQ(Geometry::area(tri), areas[e]);
+		EXPECT_EQ(Geometry::normal(tri), normals[e]);
+		EXPECT_EQ(Geometry::isDegenerate(tri), degenerate[e]);
+	}
+	EXPECT_TRUE(degenerate[28]);
+}
+
 }
\ No newline at end of file
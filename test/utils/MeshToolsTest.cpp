@@ -130,6 +130,39 @@ TEST_F(MeshToolsTest, checkNoCellsAreCrossed_tris_do_cross)
 	ASSERT_ANY_THROW(checkNoCellsAreCrossed(m));
 }
 
+TEST_F(MeshToolsTest, checkNoCellsAreCrossed_validation_levels)
+{
+	Mesh m = buildCubeSurfaceMesh(0.2);
+	GridTools gT(m.grid);
+	std::transform(
+		m.coordinates.begin(), m.coordinates.end(),
+		m.coordinates.begin(),
+		[&](auto const& c)
+		{
+			return gT.getRelative(c);
+		}
+	);
+
+	auto countReportedElements = [&](ValidationLevel level) {
+		try {
+			checkNoCellsAreCrossed(m, level);
+		}
+		catch (const std::runtime_error& e) {
+			std::string msg = e.what();
+			std::size_t count = 0;
+			for (auto pos = msg.find("Element:"); pos != std::string::npos; pos = msg.find("Element:", pos + 1)) {
+				count++;
+			}
+			return count;
+		}
+		return std::size_t(0);
+	};
+
+	EXPECT_EQ(0, countReportedElements(ValidationLevel::None));
+	EXPECT_EQ(1, countReportedElements(ValidationLevel::Cheap));
+	EXPECT_EQ(m.countElems(), countReportedElements(ValidationLevel::Full));
+}
+
 TEST_F(MeshToolsTest, checkNoCellsAreCrossed_tris_no_cross)
 {
 	auto m{ core::Slicer{buildCubeSurfaceMesh(0.2)}.getMesh() };
@@ -524,6 +557,41 @@ TEST_F(MeshToolsTest, duplicateCoordinatesSharedBySingleTrianglesVertex_3)
 	EXPECT_EQ(CoordinateIds({6, 4, 7}), r.groups[0].elements[3].vertices);
 }
 
+TEST_F(MeshToolsTest, duplicateCoordinatesSharedBySingleTrianglesVertex_many_parts)
+{
+	// Three parts touching only at vertex 0. Parts are numbered by their first
+	// element, the second one being formed by elements 1 and 3.
+	Mesh m;
+	m.grid = meshFixtures::buildUnitLengthGrid(1.0);
+	m.coordinates = {
+		Coordinate({0.50, 0.50, 0.00}),
+		Coordinate({0.00, 0.00, 0.00}),
+		Coordinate({0.50, 0.00, 0.00}),
+		Coordinate({1.00, 0.50, 0.00}),
+		Coordinate({1.00, 1.00, 0.00}),
+		Coordinate({0.00, 1.00, 0.00}),
+		Coordinate({0.00, 0.50, 0.00}),
+		Coordinate({0.10, 0.90, 0.00}),
+	};
+	m.groups = { Group() };
+	m.groups[0].elements = {
+		Element({0, 1, 2}),
+		Element({6, 5, 7}),
+		Element({0, 3, 4}),
+		Element({0, 5, 6}),
+	};
+
+	Mesh r = duplicateCoordinatesSharedBySingleTrianglesVertex(m);
+
+	ASSERT_EQ(10, r.coordinates.size());
+	EXPECT_EQ(r.coordinates[0], r.coordinates[8]);
+	EXPECT_EQ(r.coordinates[0], r.coordinates[9]);
+	EXPECT_EQ(CoordinateIds({0, 1, 2}), r.groups[0].elements[0].vertices);
+	EXPECT_EQ(CoordinateIds({6, 5, 7}), r.groups[0].elements[1].vertices);
+	EXPECT_EQ(CoordinateIds({9, 3, 4}), r.groups[0].elements[2].vertices);
+	EXPECT_EQ(CoordinateIds({8, 5, 6}), r.groups[0].elements[3].vertices);
+}
+
 TEST_F(MeshToolsTest, getElementsBoundingBox)
 {
 	Mesh m = buildTriOutOfGridMesh();
@@ -555,6 +623,18 @@ TEST_F(MeshToolsTest, getBoundingBox_epsilon_coord)
 	EXPECT_EQ(VecD({ 1.99, 1.99, 0.5}), bb.second);
 }
 
+TEST_F(MeshToolsTest, getBoundingBox_ignores_unused_coordinates)
+{
+	Mesh m = buildTriPartiallyOutOfGridMesh(1.0);
+	m.coordinates.push_back(Coordinate({ -100.0, -100.0, -100.0 }));
+	m.coordinates.push_back(Coordinate({ 100.0, 100.0, 100.0 }));
+
+	auto bb = getElementsBoundingBox(m);
+
+	EXPECT_EQ(VecD({-10.00, 0.01, 0.5 }), bb.first);
+	EXPECT_EQ(VecD({ 1.99, 1.99, 0.5 }), bb.second);
+}
+
 TEST_F(MeshToolsTest, getEnlargedGridIncludingAllElements)
 {
 	{
@@ -623,4 +703,38 @@ TEST_F(MeshToolsTest, reduceGrid_epsilon_coord)
 	}
 }
 
+
+TEST_F(MeshToolsTest, reorderSpatially)
+{
+	Mesh m;
+	m.coordinates = {
+		Coordinate({ 1.5, 1.5, 0.5 }),
+		Coordinate({ 0.2, 0.2, 0.5 }),
+		Coordinate({ 1.8, 1.2, 0.5 }),
+		Coordinate({ 0.8, 0.2, 0.5 }),
+		Coordinate({ 0.2, 0.8, 0.5 }),
+		Coordinate({ 1.2, 1.8, 0.5 }),
+	};
+	m.groups = { Group{} };
+	m.groups[0].elements = {
+		Element({ 0, 2, 5 }, Element::Type::Surface),
+		Element({ 1, 3, 4 }, Element::Type::Surface),
+	};
+	Mesh original = m;
+
+	meshTools::reorderSpatially(m);
+
+	EXPECT_EQ(Coordinates({
+		Coordinate({ 0.2, 0.2, 0.5 }),
+		Coordinate({ 0.8, 0.2, 0.5 }),
+		Coordinate({ 0.2, 0.8, 0.5 }),
+		Coordinate({ 1.5, 1.5, 0.5 }),
+		Coordinate({ 1.8, 1.2, 0.5 }),
+		Coordinate({ 1.2, 1.8, 0.5 }),
+	}), m.coordinates);
+	ASSERT_EQ(2, m.groups[0].elements.size());
+	EXPECT_EQ(std::vector<CoordinateId>({ 0, 1, 2 }), m.groups[0].elements[0].vertices);
+	EXPECT_EQ(std::vector<CoordinateId>({ 3, 4, 5 }), m.groups[0].elements[1].vertices);
+}
+
 }
\ No newline at end of file
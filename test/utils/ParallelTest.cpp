@@ -0,0 +1,172 @@
+#include "gtest/gtest.h"
+
+#include "Parallel.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace meshlib::utils {
+
+class ParallelTest : public ::testing::TestWithParam<ExecutionBackend> {
+public:
+	static ExecutionOptions buildOptions(std::size_t numberOfThreads)
+	{
+		ExecutionOptions res;
+		res.backend = GetParam();
+		res.numberOfThreads = numberOfThreads;
+		return res;
+	}
+};
+
+TEST_P(ParallelTest, for_visits_each_index_once)
+{
+	const ScopedExecution execution(buildOptions(4));
+
+	std::vector<int> visits(10000, 0);
+	parallelFor(0, visits.size(), [&](std::size_t i) { visits[i]++; });
+
+	EXPECT_EQ(std::vector<int>(visits.size(), 1), visits);
+}
+
+TEST_P(ParallelTest, for_each_and_empty_ranges)
+{
+	const ScopedExecution execution(buildOptions(4));
+
+	std::vector<std::size_t> values(1000);
+	parallelForEach(values.begin(), values.end(), [&](std::size_t& v) { v = &v - &values.front(); });
+	for (std::size_t i = 0; i < values.size(); i++) {
+		EXPECT_EQ(i, values[i]);
+	}
+
+	parallelFor(5, 5, [](std::size_t) { FAIL(); });
+	parallelFor(5, 2, [](std::size_t) { FAIL(); });
+}
+
+TEST_P(ParallelTest, reduce_is_deterministic)
+{
+	std::vector<double> values(100000);
+	for (std::size_t i = 0; i < values.size(); i++) {
+		values[i] = 1.0 / double(i + 1);
+	}
+	auto sum = [&]() {
+		return parallelReduce(std::size_t(0), values.size(), 0.0,
+			[&](std::size_t i) { return values[i]; },
+			[](double a, double b) { return a + b; });
+	};
+
+	double serialSum;
+	{
+		const ScopedExecution execution({ ExecutionBackend::Serial, 1 });
+		serialSum = sum();
+	}
+	for (std::size_t threads : { 2, 3, 8 }) {
+		const ScopedExecution execution(buildOptions(threads));
+		EXPECT_EQ(serialSum, sum());
+	}
+	EXPECT_NEAR(std::accumulate(values.begin(), values.end(), 0.0), serialSum, 1e-9);
+}
+
+TEST_P(ParallelTest, rethrows_exceptions)
+{
+	const ScopedExecution execution(buildOptions(4));
+
+	EXPECT_THROW(
+		parallelFor(0, 1000, [](std::size_t i) {
+			if (i == 500) {
+				throw std::runtime_error("Failed.");
+			}
+		}),
+		std::runtime_error);
+
+	std::atomic<std::size_t> count{ 0 };
+	parallelFor(0, 1000, [&](std::size_t) { count++; });
+	EXPECT_EQ(1000, count);
+}
+
+TEST_P(ParallelTest, nested_loops_run_in_caller_thread)
+{
+	const ScopedExecution execution(buildOptions(4));
+
+	std::vector<int> nestedInSameThread(64, 1);
+	parallelFor(0, nestedInSameThread.size(), [&](std::size_t i) {
+		const auto outer = std::this_thread::get_id();
+		parallelFor(0, 100, [&](std::size_t) {
+			if (std::this_thread::get_id() != outer) {
+				nestedInSameThread[i] = 0;
+			}
+		});
+	});
+
+	EXPECT_EQ(std::vector<int>(nestedInSameThread.size(), 1), nestedInSameThread);
+}
+
+TEST_P(ParallelTest, task_group_runs_all_tasks)
+{
+	const ScopedExecution execution(buildOptions(3));
+
+	std::vector<int> done(5, 0);
+	TaskGroup tasks;
+	for (std::size_t t = 0; t < done.size(); t++) {
+		tasks.run([&, t]() { done[t] = 1; });
+	}
+	tasks.wait();
+
+	EXPECT_EQ(std::vector<int>(done.size(), 1), done);
+}
+
+TEST_P(ParallelTest, limits_number_of_threads)
+{
+	std::mutex mutex;
+	std::set<std::thread::id> ids;
+	{
+		const ScopedExecution execution(buildOptions(2));
+		parallelFor(0, 256, [&](std::size_t) {
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+			std::lock_guard<std::mutex> lock(mutex);
+			ids.insert(std::this_thread::get_id());
+		});
+	}
+
+	EXPECT_GE(2, ids.size());
+	if (GetParam() == ExecutionBackend::Serial) {
+		EXPECT_EQ(1, ids.size());
+	}
+}
+
+INSTANTIATE_TEST_SUITE_P(
+	Backends,
+	ParallelTest,
+	::testing::Values(ExecutionBackend::Serial, ExecutionBackend::Threads));
+
+TEST(ParallelOptionsTest, scoped_execution_restores_previous_options)
+{
+	const ExecutionOptions before = getExecution();
+	{
+		const ScopedExecution execution({ ExecutionBackend::Threads, 3 });
+		EXPECT_EQ(ExecutionBackend::Threads, getExecution().backend);
+		EXPECT_EQ(3, getExecution().numberOfThreads);
+		{
+			const ScopedExecution inner({ ExecutionBackend::Default, 2 });
+			EXPECT_EQ(ExecutionBackend::Threads, getExecution().backend);
+			EXPECT_EQ(2, getExecution().numberOfThreads);
+		}
+		EXPECT_EQ(3, getExecution().numberOfThreads);
+	}
+	EXPECT_EQ(before.backend, getExecution().backend);
+	EXPECT_EQ(before.numberOfThreads, getExecution().numberOfThreads);
+}
+
+TEST(ParallelOptionsTest, backend_from_string)
+{
+	EXPECT_EQ(ExecutionBackend::Serial, toExecutionBackend("serial"));
+	EXPECT_EQ(ExecutionBackend::Threads, toExecutionBackend("threads"));
+	EXPECT_EQ(ExecutionBackend::TBB, toExecutionBackend("tbb"));
+	EXPECT_THROW(toExecutionBackend("openmp"), std::runtime_error);
+}
+
+}
@@ -359,6 +359,44 @@ TEST_F(RedundancyCleanerTest, doNotRemoveOppositeLines)
 	EXPECT_EQ(resultMesh, m);
 }
 
+TEST_F(RedundancyCleanerTest, removeRepeatedElementsIgnoringOrientation)
+{
+	auto m{ buildCubeSurfaceMesh(1.0) };
+
+	auto r{ m };
+	r.groups[0].elements.push_back(m.groups[0].elements.back());
+	auto& e = r.groups[0].elements.back();
+	std::reverse(e.vertices.begin(), e.vertices.end());
+
+	auto rOriented{ r };
+	RedundancyCleaner::removeRepeatedElements(rOriented);
+	EXPECT_EQ(m.groups[0].elements.size() + 1, rOriented.groups[0].elements.size());
+
+	RedundancyCleaner::removeRepeatedElementsIgnoringOrientation(r);
+	EXPECT_EQ(m, r);
+}
+
+TEST_F(RedundancyCleanerTest, removeOverlappedLinesKeepsLineWithGreaterDirection)
+{
+	Mesh m;
+	m.grid = buildUnitLengthGrid(0.2);
+	m.coordinates = {
+		Coordinate({0.25, 0.25, 0.25}),
+		Coordinate({0.75, 0.75, 0.75}),
+	};
+	m.groups.resize(1);
+	m.groups[0].elements = {
+		Element({1, 0}, Element::Type::Line),
+		Element({0, 1}, Element::Type::Line),
+		Element({1, 0}, Element::Type::Line),
+	};
+
+	RedundancyCleaner::removeOverlappedDimensionOneAndLowerElementsAndEquivalentSurfaces(m);
+
+	ASSERT_EQ(1, m.groups[0].elements.size());
+	EXPECT_EQ(Element({0, 1}, Element::Type::Line), m.groups[0].elements[0]);
+}
+
 TEST_F(RedundancyCleanerTest, removeElementsWithCondition)
 {
 	Mesh m;
@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+
+#include "utils/UnionFind.h"
+
+namespace meshlib::utils {
+
+class UnionFindTest : public ::testing::Test {};
+
+TEST_F(UnionFindTest, unite_and_find)
+{
+	UnionFind sets(6);
+	EXPECT_TRUE(sets.unite(0, 3));
+	EXPECT_TRUE(sets.unite(4, 3));
+	EXPECT_FALSE(sets.unite(0, 4));
+	EXPECT_TRUE(sets.unite(1, 5));
+
+	EXPECT_EQ(sets.find(0), sets.find(4));
+	EXPECT_EQ(sets.find(1), sets.find(5));
+	EXPECT_NE(sets.find(0), sets.find(1));
+	EXPECT_NE(sets.find(2), sets.find(0));
+}
+
+TEST_F(UnionFindTest, labels_follow_smallest_index)
+{
+	UnionFind sets(6);
+	sets.unite(5, 1);
+	sets.unite(3, 0);
+	sets.unite(4, 3);
+
+	std::vector<std::size_t> labels;
+	std::size_t numberOfSets;
+	std::tie(labels, numberOfSets) = sets.labels();
+	EXPECT_EQ(3, numberOfSets);
+	EXPECT_EQ(std::vector<std::size_t>({ 0, 1, 2, 0, 0, 1 }), labels);
+}
+
+}
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+
+#include "VoxelIndex.h"
+
+#include <random>
+
+namespace meshlib::utils {
+
+class VoxelIndexTest : public ::testing::Test {
+public:
+	static Coordinates buildRandomCoordinates(std::size_t n, double size)
+	{
+		std::mt19937 gen(1);
+		std::uniform_real_distribution<double> dist(0.0, size);
+		Coordinates res(n);
+		for (auto& c : res) {
+			c = Coordinate({ dist(gen), dist(gen), dist(gen) });
+		}
+		// Half of the coordinates lie on grid planes.
+		for (std::size_t i = 0; i < n; i += 2) {
+			res[i](i % 3) = std::round(res[i](i % 3));
+		}
+		return res;
+	}
+
+	static Elements buildTriangles(std::size_t numberOfCoordinates)
+	{
+		Elements res;
+		for (CoordinateId i = 0; i + 2 < numberOfCoordinates; i++) {
+			res.push_back(Element({ i, i + 1, i + 2 }, Element::Type::Surface));
+		}
+		return res;
+	}
+
+	static void expectSameCellElemMap(
+		const std::map<Cell, std::vector<const Element*>>& expected,
+		const std::map<Cell, ElementsView>& actual)
+	{
+		ASSERT_EQ(expected.size(), actual.size());
+		for (auto const& [cell, elems] : expected) {
+			ASSERT_EQ(1, actual.count(cell));
+			EXPECT_EQ(elems, actual.at(cell));
+		}
+	}
+};
+
+TEST_F(VoxelIndexTest, builds_same_cells_as_grid_tools)
+{
+	GridTools gT{ GridTools::buildCartesianGrid(0.0, 20.0, 21) };
+	Coordinates cs = buildRandomCoordinates(500, 20.0);
+	Elements es = buildTriangles(cs.size());
+
+	VoxelIndex index(gT, es, cs);
+
+	EXPECT_EQ(es.size(), index.elementsSize());
+	expectSameCellElemMap(gT.buildCellElemMap(es, cs), index.buildCellElemMap(es));
+}
+
+TEST_F(VoxelIndexTest, builds_same_cells_as_grid_tools_without_grid)
+{
+	GridTools gT;
+	Coordinates cs = buildRandomCoordinates(500, 20.0);
+	Elements es = buildTriangles(cs.size());
+
+	VoxelIndex index(gT, es, cs);
+
+	expectSameCellElemMap(gT.buildCellElemMap(es, cs), index.buildCellElemMap(es));
+}
+
+TEST_F(VoxelIndexTest, unoccupied_cells_have_no_elements)
+{
+	GridTools gT{ GridTools::buildCartesianGrid(0.0, 20.0, 21) };
+	Coordinates cs = {
+		Coordinate({ 9.1, 9.1, 9.5 }),
+		Coordinate({ 9.9, 9.1, 9.5 }),
+		Coordinate({ 9.1, 9.9, 9.5 })
+	};
+	Elements es = { Element({ 0, 1, 2 }, Element::Type::Surface) };
+
+	VoxelIndex index(gT, es, cs);
+
+	EXPECT_TRUE(index.isOccupied(Cell({ 9, 9, 9 })));
+	EXPECT_EQ(std::vector<ElementId>({ 0 }), index.getElementIds(Cell({ 9, 9, 9 })));
+	EXPECT_FALSE(index.isOccupied(Cell({ 8, 9, 9 })));
+	EXPECT_TRUE(index.getElementIds(Cell({ 8, 9, 9 })).empty());
+	EXPECT_FALSE(index.isOccupied(Cell({ 100, 0, 0 })));
+	EXPECT_EQ(std::vector<Cell>({ Cell({ 9, 9, 9 }) }), index.getOccupiedCells());
+}
+
+TEST_F(VoxelIndexTest, insert_and_erase_elements)
+{
+	GridTools gT{ GridTools::buildCartesianGrid(0.0, 20.0, 21) };
+	Coordinates cs = buildRandomCoordinates(500, 20.0);
+	Elements es = buildTriangles(cs.size());
+
+	VoxelIndex index(gT, es, cs);
+
+	for (CoordinateId i = 0; i + 10 < cs.size(); i += 10) {
+		es.push_back(Element({ i, i + 5, i + 10 }, Element::Type::Surface));
+		index.insert(es.back(), cs);
+	}
+
+	IdSet toRemove;
+	for (ElementId e = 0; e < es.size(); e += 3) {
+		toRemove.insert(e);
+	}
+	Elements remaining;
+	for (ElementId e = 0; e < es.size(); e++) {
+		if (!toRemove.count(e)) {
+			remaining.push_back(es[e]);
+		}
+	}
+	index.erase(toRemove);
+
+	EXPECT_EQ(remaining.size(), index.elementsSize());
+	expectSameCellElemMap(gT.buildCellElemMap(remaining, cs), index.buildCellElemMap(remaining));
+}
+
+}